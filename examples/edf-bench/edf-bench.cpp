@@ -0,0 +1,541 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDEA MMR SDK                      //
+//               benchmark harness (edf-bench)           //
+///////////////////////////////////////////////////////////
+
+// Eyedea MMR include - include path to sdk/include must be added
+#include <edf.h>
+#include <edf_type_mmr.h>
+
+#include <algorithm>
+#include <chrono>  // time measure
+#include <cstdio>
+#include <cstring>
+#include <fstream> // annotation reading
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// CONSTANTS - SDK PATH, MODULE NAME, MODELS                                  //
+////////////////////////////////////////////////////////////////////////////////
+const char *EDF_SDK_PATH            = "../../sdk/";
+const char *DEFAULT_EDF_MODULE_NAME = "edftf2lite"; // module name depends on the type and version
+
+enum MMRTask { VCMMGVCT=0, VCMMCT=1, VCMCT=2, VCCT=3 }; //< helper enum for indexing models
+enum MMRType { LP = 0, CARBOX = 1 };                    //< helper enum for indexing crop type
+const char *MMR_FAST_MODELS[] = {"MMR_VCMMGVCT_FAST_2024Q2.dat", "MMRBOX_VCMMGVCT_FAST_2024Q2.dat",
+                                 "MMR_VCMMCT_FAST_2024Q2.dat",   "MMRBOX_VCMMCT_FAST_2024Q2.dat",
+                                 "MMR_VCMCT_FAST_2024Q2.dat",    "MMRBOX_VCMCT_FAST_2024Q2.dat",
+                                 "MMR_VCCT_FAST_2024Q2.dat",     "MMRBOX_VCCT_FAST_2024Q2.dat"};
+const char *MMR_PREC_MODELS[] = {"MMR_VCMMGVCT_PREC_2024Q2.dat", "MMRBOX_VCMMGVCT_PREC_2024Q2.dat",
+                                 "MMR_VCMMCT_PREC_2024Q2.dat",   "MMRBOX_VCMMCT_PREC_2024Q2.dat",
+                                 "MMR_VCMCT_PREC_2024Q2.dat",    "MMRBOX_VCMCT_PREC_2024Q2.dat",
+                                 "MMR_VCCT_PREC_2024Q2.dat",     "MMRBOX_VCCT_PREC_2024Q2.dat"};
+
+const char *DEFAULT_DATA_DIR    = "./"; // annotations.txt of the example images of data/images-mmr
+const char *ANNOTATION_FILE     = "annotations.txt";
+const char *DEFAULT_THREADS     = "1";
+const char *DEFAULT_BATCH_SIZES = "1";
+const char *DEFAULT_PROVIDERS   = "cpu";
+const int   DEFAULT_GPU_ID      = 0; // first gpu device
+const int   DEFAULT_ITERATIONS  = 10;
+const int   DEFAULT_WARMUP      = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+// INPUT IMAGES AND ANNOTATIONS                                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/** One annotated vehicle, the LP and CARBOX positions as in example-mmr-API
+ */
+struct BenchInput {
+    std::string filename;
+    float lp[4];     //!< center x, center y, resolution in pixels per meter, rotation in degrees
+    float carbox[4]; //!< top left x, y, bottom right x, y
+    ERImage image;
+};
+
+/** Measured configuration and its results
+ */
+struct BenchRun {
+    ERComputationMode computation_mode;
+    int gpu_id;
+    std::string provider;
+    int num_threads;
+    unsigned int batch_size;
+    int code;                    //!< 0 on success, failed SDK call return code otherwise
+    double init_ms;
+    double wall_ms;
+    size_t num_vehicles;              //!< measured inputs, the duplicates filling up the last batch excluded
+    std::vector<double> crop_ms;      //!< per vehicle
+    std::vector<double> desc_ms;      //!< per edfComputeDesc call (one batch)
+    std::vector<double> classify_ms;  //!< per vehicle
+    std::vector<double> total_ms;     //!< per batch, crop + descriptor + classification
+    double peak_rss_mb;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// HELPER FUNCTIONS DECLARATIONS, DEFINITIONS ARE AT THE END OF THE FILE      //
+////////////////////////////////////////////////////////////////////////////////
+int parse_arguments(int argc, char * argv[], bool &help, bool &fast_version, MMRType &mmr_type, MMRTask &mmr_task,
+                    ERComputationMode &computation_mode, int &gpu_id, std::string &module_name,
+                    std::string &data_dir, std::string &threads, std::string &batch_sizes, std::string &providers,
+                    int &iterations, int &warmup, std::string &output_file);
+bool loadInputs(EdfAPI &api, const std::string &data_dir, std::vector<BenchInput> &inputs);
+EdfCropParams setEdfCropParams(EdfAPI &api, const BenchInput &input, MMRType mmr_type);
+std::vector<std::string> splitList(const std::string &list);
+double percentile(std::vector<double> values, double p); //< nearest-rank percentile
+double peakRssMb();
+void writeJson(FILE *file, const std::string &model, const std::vector<BenchRun> &runs);
+
+typedef std::chrono::steady_clock::time_point time_point;
+double elapsedMs(time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.;
+}
+
+// Runs one pass over all inputs in batches, appends the measured times to run. Returns 0 or the failed call code.
+int runPass(EdfAPI &api, void *mmr_state, std::vector<BenchInput> &inputs, std::vector<EdfCropParams> &params,
+            BenchRun &run, bool measure)
+{
+    unsigned int batch_size = run.batch_size;
+    std::vector<ERImage> crops(batch_size);
+    std::vector<EdfDescriptor> descriptors(batch_size);
+    EdfComputeDescConfig desc_config{};
+    desc_config.batch_size = batch_size;
+    for (size_t first = 0; first < inputs.size(); first += batch_size) {
+        // The last batch is filled up with the first inputs to keep the batch size constant.
+        time_point batch_start = std::chrono::steady_clock::now();
+        for (unsigned int b = 0; b < batch_size; b++) {
+            size_t index = (first + b) % inputs.size();
+            time_point start = std::chrono::steady_clock::now();
+            int code = api.edfCropImage(&inputs[index].image, &params[index], mmr_state, &crops[b], nullptr);
+            if (code != 0) {
+                for (unsigned int c = 0; c < b; c++) api.edfFreeCropImage(mmr_state, &crops[c]);
+                return code;
+            }
+            if (measure) run.crop_ms.push_back(elapsedMs(start));
+        }
+
+        time_point start = std::chrono::steady_clock::now();
+        int code = api.edfComputeDesc(&crops[0], mmr_state, &descriptors[0], batch_size > 1 ? &desc_config : nullptr);
+        if (measure) run.desc_ms.push_back(elapsedMs(start));
+        for (unsigned int b = 0; b < batch_size; b++) api.edfFreeCropImage(mmr_state, &crops[b]);
+        if (code != 0) return code;
+
+        for (unsigned int b = 0; b < batch_size && code == 0; b++) {
+            EdfClassifyResult *classify_result = nullptr;
+            start = std::chrono::steady_clock::now();
+            code = api.edfClassify(&descriptors[b], mmr_state, &classify_result, nullptr);
+            if (measure) run.classify_ms.push_back(elapsedMs(start));
+            if (code == 0) api.edfFreeClassifyResult(&classify_result, mmr_state);
+        }
+        for (unsigned int b = 0; b < batch_size; b++) api.edfFreeDesc(&descriptors[b]);
+        if (code != 0) return code;
+        if (measure) {
+            run.total_ms.push_back(elapsedMs(batch_start));
+            run.num_vehicles += std::min<size_t>(batch_size, inputs.size() - first);
+        }
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Eyedea MMR benchmark harness                                                      //
+///////////////////////////////////////////////////////////////////////////////////////
+//   Replays a directory of annotated images through edfCropImage -> edfComputeDesc  //
+//   -> edfClassify for every combination of the ONNX provider, number of threads    //
+//   and batch size, and reports the throughput, the p50/p95/p99 latencies of every  //
+//   stage and the peak RSS as JSON.                                                 //
+///////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char * argv[]) {
+    bool option_fast_version = true;
+    MMRType option_mmr_type = MMRType::LP;
+    MMRTask option_mmr_task = MMRTask::VCMMCT;
+    ERComputationMode option_computation_mode = ER_COMPUTATION_MODE_CPU;
+    int option_gpu_id = DEFAULT_GPU_ID;
+    std::string option_module = DEFAULT_EDF_MODULE_NAME;
+    std::string option_data_dir = DEFAULT_DATA_DIR;
+    std::string option_threads = DEFAULT_THREADS;
+    std::string option_batch_sizes = DEFAULT_BATCH_SIZES;
+    std::string option_providers = DEFAULT_PROVIDERS;
+    int option_iterations = DEFAULT_ITERATIONS;
+    int option_warmup = DEFAULT_WARMUP;
+    std::string option_output;
+    bool help = false;
+    if (parse_arguments(argc, argv, help, option_fast_version, option_mmr_type, option_mmr_task,
+                        option_computation_mode, option_gpu_id, option_module, option_data_dir, option_threads,
+                        option_batch_sizes, option_providers, option_iterations, option_warmup, option_output) != 0) {
+        std::cerr << "Argument parsing failed!\n";
+        return -1;
+    }
+    if (help) return 0;
+
+    EdfAPI edfAPI;
+    edfLinkAPI(nullptr, &edfAPI);
+
+    std::vector<BenchInput> inputs;
+    if (!loadInputs(edfAPI, option_data_dir, inputs)) {
+        return -1;
+    }
+    std::vector<EdfCropParams> params;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        params.push_back(setEdfCropParams(edfAPI, inputs[i], option_mmr_type));
+    }
+
+    std::string edfModulePath = std::string(EDF_SDK_PATH) + "modules/" + option_module + "/";
+    const char *mmr_model = option_fast_version ? MMR_FAST_MODELS[2*option_mmr_task+option_mmr_type]
+                                                : MMR_PREC_MODELS[2*option_mmr_task+option_mmr_type];
+    std::vector<std::string> providers = splitList(option_providers);
+    std::vector<std::string> threads = splitList(option_threads);
+    std::vector<std::string> batch_sizes = splitList(option_batch_sizes);
+
+    //////////////////////////////////////////////////////////////
+    // Sweep over the providers, numbers of threads and batch sizes
+    //////////////////////////////////////////////////////////////
+    std::vector<BenchRun> runs;
+    for (size_t p = 0; p < providers.size(); p++) {
+        for (size_t t = 0; t < threads.size(); t++) {
+            BenchRun base{};
+            base.computation_mode = option_computation_mode;
+            base.gpu_id = option_gpu_id;
+            base.provider = providers[p];
+            base.num_threads = atoi(threads[t].c_str());
+
+            EdfInitConfig config{};
+            config.module_path      = edfModulePath.c_str();
+            config.model_file       = mmr_model;
+            config.computation_mode = base.computation_mode;
+            config.gpu_device_id    = base.gpu_id;
+            config.num_threads      = base.num_threads;
+            config.onnx_provider    = base.provider.c_str();
+            void *mmr_state = nullptr;
+            time_point start = std::chrono::steady_clock::now();
+            int init_code = edfAPI.edfInitEyedentify(&config, &mmr_state);
+            base.init_ms = elapsedMs(start);
+
+            for (size_t b = 0; b < batch_sizes.size(); b++) {
+                BenchRun run = base;
+                run.batch_size = std::max(1, atoi(batch_sizes[b].c_str()));
+                run.code = init_code;
+                std::cerr << "provider " << run.provider << ", threads " << run.num_threads << ", batch "
+                          << run.batch_size << "..." << std::endl;
+                for (int i = 0; i < option_warmup && run.code == 0; i++) {
+                    run.code = runPass(edfAPI, mmr_state, inputs, params, run, false);
+                }
+                start = std::chrono::steady_clock::now();
+                for (int i = 0; i < option_iterations && run.code == 0; i++) {
+                    run.code = runPass(edfAPI, mmr_state, inputs, params, run, true);
+                }
+                run.wall_ms = elapsedMs(start);
+                run.peak_rss_mb = peakRssMb();
+                if (run.code != 0) {
+                    std::cerr << "\tfailed with code " << run.code << std::endl;
+                }
+                runs.push_back(run);
+            }
+            if (init_code == 0) {
+                edfAPI.edfFreeEyedentify(&mmr_state);
+            }
+        }
+    }
+
+    //////////////////////////////////////////////////////////////
+    // Report
+    //////////////////////////////////////////////////////////////
+    FILE *output = stdout;
+    if (!option_output.empty()) {
+        output = fopen(option_output.c_str(), "w");
+        if (!output) {
+            std::cerr << "Error during " << option_output << " opening!\n";
+            output = stdout;
+        }
+    }
+    writeJson(output, mmr_model, runs);
+    if (output != stdout) fclose(output);
+
+    //////////////////////////////////////////////////////////////
+    // Cleaning up
+    //////////////////////////////////////////////////////////////
+    for (size_t i = 0; i < inputs.size(); i++) {
+        edfAPI.edfCropParamsFree(&params[i]);
+        edfAPI.erImageFree(&inputs[i].image);
+    }
+    return 0;
+}
+
+bool loadInputs(EdfAPI &api, const std::string &data_dir, std::vector<BenchInput> &inputs)
+{
+    // Annotation line: image_file lp_center_x lp_center_y lp_resolution_ppm lp_rotation_dgr
+    //                  carbox_top_left_x carbox_top_left_y carbox_bottom_right_x carbox_bottom_right_y
+    std::string annotation_path = data_dir + "/" + ANNOTATION_FILE;
+    std::ifstream file(annotation_path.c_str());
+    if (!file.is_open()) {
+        std::cerr << "Error during " << annotation_path << " reading!\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        BenchInput input;
+        fields >> input.filename >> input.lp[0] >> input.lp[1] >> input.lp[2] >> input.lp[3]
+               >> input.carbox[0] >> input.carbox[1] >> input.carbox[2] >> input.carbox[3];
+        if (fields.fail()) {
+            std::cerr << "Invalid annotation: " << line << "\n";
+            return false;
+        }
+        std::memset(&input.image, 0, sizeof(ERImage));
+        std::string image_path = data_dir + "/" + input.filename;
+        if (api.erImageRead(&input.image, image_path.c_str()) != 0) {
+            std::cerr << "Error during " << image_path << " image reading!\n";
+            return false;
+        }
+        inputs.push_back(input);
+    }
+    if (inputs.empty()) {
+        std::cerr << "No annotated image in " << annotation_path << "!\n";
+        return false;
+    }
+    return true;
+}
+
+EdfCropParams setEdfCropParams(EdfAPI &api, const BenchInput &input, MMRType mmr_type)
+{
+    EdfCropParams params;
+    if (mmr_type == MMRType::LP) {
+        api.edfCropParamsAllocate(EDF_MMR_CROP_POINTS, EDF_MMR_CROP_VALUES, &params);
+        EDF_LP_CENTER_X(params)       = input.lp[0];
+        EDF_LP_CENTER_Y(params)       = input.lp[1];
+        EDF_LP_SCALE_PX_PER_M(params) = input.lp[2];
+        EDF_LP_ROTATION(params)       = input.lp[3];
+    } else {
+        api.edfCropParamsAllocate(EDF_MMRBOX_CROP_POINTS, EDF_MMRBOX_CROP_VALUES, &params);
+        EDF_MMRBOX_TOP_LEFT_X(params)     = input.carbox[0];
+        EDF_MMRBOX_TOP_LEFT_Y(params)     = input.carbox[1];
+        EDF_MMRBOX_BOTTOM_RIGHT_X(params) = input.carbox[2];
+        EDF_MMRBOX_BOTTOM_RIGHT_Y(params) = input.carbox[3];
+    }
+    return params;
+}
+
+std::vector<std::string> splitList(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t rank = (size_t)(p / 100.0 * values.size() + 0.999999);
+    return values[std::min(values.size(), std::max((size_t)1, rank)) - 1];
+}
+
+double peakRssMb()
+{
+#if _WIN32 || _WIN64
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+    return usage.ru_maxrss / 1024.0;            // kilobytes
+#endif
+#endif
+}
+
+void writeStage(FILE *file, const char *name, const std::vector<double> &values, bool last)
+{
+    fprintf(file, "        \"%s\": {\"count\": %zu, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f}%s\n", name,
+            values.size(), percentile(values, 50), percentile(values, 95), percentile(values, 99), last ? "" : ",");
+}
+
+void writeJson(FILE *file, const std::string &model, const std::vector<BenchRun> &runs)
+{
+    fprintf(file, "{\n  \"model\": \"%s\",\n  \"runs\": [\n", model.c_str());
+    for (size_t i = 0; i < runs.size(); i++) {
+        const BenchRun &run = runs[i];
+        double throughput = run.wall_ms > 0.0 ? run.num_vehicles * 1000.0 / run.wall_ms : 0.0;
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"computation_mode\": \"%s\",\n",
+                run.computation_mode == ER_COMPUTATION_MODE_GPU ? "gpu" : "cpu");
+        fprintf(file, "      \"gpu_id\": %d,\n", run.gpu_id);
+        fprintf(file, "      \"onnx_provider\": \"%s\",\n", run.provider.c_str());
+        fprintf(file, "      \"num_threads\": %d,\n", run.num_threads);
+        fprintf(file, "      \"batch_size\": %u,\n", run.batch_size);
+        fprintf(file, "      \"code\": %d,\n", run.code);
+        fprintf(file, "      \"init_ms\": %.3f,\n", run.init_ms);
+        fprintf(file, "      \"vehicles\": %zu,\n", run.num_vehicles);
+        fprintf(file, "      \"throughput_per_s\": %.3f,\n", throughput);
+        fprintf(file, "      \"peak_rss_mb\": %.1f,\n", run.peak_rss_mb);
+        fprintf(file, "      \"latency\": {\n");
+        writeStage(file, "crop", run.crop_ms, false);
+        writeStage(file, "descriptor", run.desc_ms, false);
+        writeStage(file, "classify", run.classify_ms, false);
+        writeStage(file, "total", run.total_ms, true);
+        fprintf(file, "      }\n    }%s\n", i + 1 < runs.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+bool check_arg(const char *arg, std::string option, std::string &retv)
+{
+    if (option.back()!='=' && strlen(arg) != option.length())
+        return false;
+
+    if (option.compare(0,option.length(),arg,option.length()) == 0)
+    {
+        retv.assign(arg+option.length());
+        return true;
+    }
+    return false;
+}
+
+int parse_arguments(int argc, char * argv[], bool &help, bool &fast_version, MMRType &mmr_type, MMRTask &mmr_task,
+                    ERComputationMode &computation_mode, int &gpu_id, std::string &module_name,
+                    std::string &data_dir, std::string &threads, std::string &batch_sizes, std::string &providers,
+                    int &iterations, int &warmup, std::string &output_file)
+{
+    help = false;
+    for( int i = 1; i < argc; i++ )
+    {
+        std::string retv;
+        if (check_arg(argv[i], "-vcmmgvct", retv) || check_arg(argv[i], "-VCMMGVCT", retv))
+            mmr_task = VCMMGVCT;
+        else if (check_arg(argv[i], "-vcmmct", retv) || check_arg(argv[i], "-VCMMCT", retv))
+            mmr_task = VCMMCT;
+        else if (check_arg(argv[i], "-vcmct", retv) || check_arg(argv[i], "-VCMCT", retv))
+            mmr_task = VCMCT;
+        else if (check_arg(argv[i], "-vcct", retv) || check_arg(argv[i], "-VCCT", retv))
+            mmr_task = VCCT;
+        else if (check_arg(argv[i], "-lp", retv))
+            mmr_type = MMRType::LP;
+        else if (check_arg(argv[i], "-carbox", retv))
+            mmr_type = MMRType::CARBOX;
+        else if (check_arg(argv[i], "-fast", retv))
+            fast_version = true;
+        else if (check_arg(argv[i], "-precise", retv))
+            fast_version = false;
+        else if (check_arg(argv[i], "-cpu", retv))
+            computation_mode = ER_COMPUTATION_MODE_CPU;
+        else if (check_arg(argv[i], "-gpu-id=", retv))
+            gpu_id = atoi(retv.c_str());
+        else if (check_arg(argv[i], "-gpu", retv))
+            computation_mode = ER_COMPUTATION_MODE_GPU;
+        else if (check_arg(argv[i], "-module=", retv))
+            module_name = retv;
+        else if (check_arg(argv[i], "-data=", retv))
+            data_dir = retv;
+        else if (check_arg(argv[i], "-threads=", retv))
+            threads = retv;
+        else if (check_arg(argv[i], "-batch=", retv))
+            batch_sizes = retv;
+        else if (check_arg(argv[i], "-onnx-provider=", retv))
+            providers = retv;
+        else if (check_arg(argv[i], "-iterations=", retv))
+            iterations = atoi(retv.c_str());
+        else if (check_arg(argv[i], "-warmup=", retv))
+            warmup = atoi(retv.c_str());
+        else if (check_arg(argv[i], "-output=", retv))
+            output_file = retv;
+        else if (check_arg(argv[i], "-h", retv) || check_arg(argv[i], "--help", retv)){
+            printf("NAME\n"
+            "        edf-bench - Benchmark of the MMR recognition chain.\n\n"
+            "SYNOPSIS\n"
+            "        Unix   : ./edf-bench [options]\n"
+            "        Windows: edf-bench.exe [options]\n"
+            "\n"
+            "DESCRIPTION\n"
+            "        The benchmark replays the annotated images of a directory through edfCropImage, edfComputeDesc\n"
+            "        and edfClassify for every combination of the ONNX provider, number of threads and batch size,\n"
+            "        and prints the throughput, the p50/p95/p99 latency of every stage and the peak RSS as JSON.\n"
+            "        The directory contains %s with one line per image:\n"
+            "          image_file lp_center_x lp_center_y lp_resolution_ppm lp_rotation_dgr\n"
+            "                     carbox_top_left_x carbox_top_left_y carbox_bottom_right_x carbox_bottom_right_y\n\n"
+            "OPTIONS\n"
+            "        -h, --help this help\n"
+            "        -vcmmgvct, -vcmmct, -vcmct, -vcct \n"
+            "                   MMR task of the model [default vcmmct]\n"
+            "        -lp        use license plate for image alignment in edfCropImage [default]\n"
+            "        -carbox    use carbox for image alignment in edfCropImage\n"
+            "        -fast      use fast models [default]\n"
+            "        -precise   use precise models\n"
+            "        -cpu       run recognition on cpu device [default]\n"
+            "        -gpu       run recognition on gpu device\n"
+            "        -gpu-id=GPU_ID \n"
+            "                   set GPU_ID gpu device for computation [default %d]\n"
+            "        -module=NAME \n"
+            "                   module in sdk/modules, e.g. edfonnx for the ONNX providers [default %s]\n"
+            "        -data=DIR \n"
+            "                   directory of the images and annotations [default %s]\n"
+            "        -threads=N[,N...] \n"
+            "                   numbers of threads to sweep, -1 for 0.9 * hardware_concurrency [default %s]\n"
+            "        -batch=N[,N...] \n"
+            "                   edfComputeDesc batch sizes to sweep [default %s]\n"
+            "        -onnx-provider=PROVIDER[,PROVIDER...] \n"
+            "                   ONNX providers to sweep, of {cpu,cuda,tensorrt,rocm,openvino} [default %s]\n"
+            "        -iterations=N \n"
+            "                   number of measured passes over the images [default %d]\n"
+            "        -warmup=N \n"
+            "                   number of passes before the measurement [default %d]\n"
+            "        -output=FILE \n"
+            "                   write the JSON report to FILE instead of the standard output\n"
+            "\n"
+            "EXAMPLE\n"
+            "        edf-bench -module=edfonnx -threads=1,4,8 -batch=1,8 -onnx-provider=cpu,cuda -output=bench.json\n"
+            "        edf-bench -module=edfonnx -precise -gpu -gpu-id=0 -batch=1,8,32 -onnx-provider=cuda,tensorrt\n"
+            "\n"
+            "(C) 2024, Eyedea Recognition s.r.o., http://www.eyedea.cz\n"
+            "\n", ANNOTATION_FILE, DEFAULT_GPU_ID, DEFAULT_EDF_MODULE_NAME, DEFAULT_DATA_DIR, DEFAULT_THREADS, DEFAULT_BATCH_SIZES,
+            DEFAULT_PROVIDERS, DEFAULT_ITERATIONS, DEFAULT_WARMUP);
+            help = true;
+            return 0;
+        }
+        else{
+            printf("WARNING: Unknown option %s\nSee `%s --help' for more information.\n",argv[i], argv[0]);
+            return -1;
+        }
+    }
+    if (iterations < 1 || warmup < 0) {
+        printf("WARNING: -iterations must be positive and -warmup non-negative\n");
+        return -1;
+    }
+    return 0;
+}
@@ -34,6 +34,15 @@
         return err_code;                                                     \
     }                                                                        \
 
+// Loads a function not exported by all library versions, the pointer is left NULL if missing.
+#if _WIN32 || _WIN64
+#define EDF_LOAD_OPTIONAL_SHLIB_FCN(fcn_ptr, fcn_type, fcn_name, state) \
+    state->fcn_ptr = (fcn_type)GetProcAddress(state->shlib_handle, fcn_name);
+#else
+#define EDF_LOAD_OPTIONAL_SHLIB_FCN(fcn_ptr, fcn_type, fcn_name, state) \
+    state->fcn_ptr = (fcn_type)dlsym(state->shlib_handle, fcn_name);
+#endif
+
 int linkEyedentify(const char* sdk_path, EdfAPI* edf_api_state) {
     if (!sdk_path || !edf_api_state) {
         return -1;
@@ -103,6 +112,9 @@ int linkEyedentify(const char* sdk_path, EdfAPI* edf_api_state) {
     EDF_LOAD_SHLIB_FCN_BODY(erImageWrite                   , fcn_erImageWrite                   , "erImageWrite"                   , edf_api_state, -26);
     EDF_LOAD_SHLIB_FCN_BODY(erImageFree                    , fcn_erImageFree                    , "erImageFree"                    , edf_api_state, -27);
     EDF_LOAD_SHLIB_FCN_BODY(erVersion                      , fcn_erVersion                      , "erVersion"                      , edf_api_state, -28);
+    // Optional functions
+    EDF_LOAD_OPTIONAL_SHLIB_FCN(edfInitEyedentify_ExternalInference, fcn_edfInitEyedentify_ExternalInference,
+                                "edfInitEyedentify_ExternalInference", edf_api_state);
 
     return 0;
 }
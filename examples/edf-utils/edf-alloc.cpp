@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-alloc.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdlib.h>
+#include <vector>
+
+static void* defaultAlloc(size_t size, size_t alignment, void* user_data) {
+    (void)user_data;
+#if _WIN32 || _WIN64
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = NULL;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+#endif
+}
+
+static void defaultFree(void* ptr, void* user_data) {
+    (void)user_data;
+#if _WIN32 || _WIN64
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+static std::mutex   g_allocator_mutex;
+static EdfAllocator g_allocator = {defaultAlloc, defaultFree, NULL};
+
+static thread_local void* g_thread_arena = NULL;
+
+static EdfAllocator currentAllocator() {
+    std::lock_guard<std::mutex> lock(g_allocator_mutex);
+    return g_allocator;
+}
+
+static size_t alignUp(size_t size) {
+    return (size + EDF_MEMORY_ALIGNMENT - 1) & ~(size_t)(EDF_MEMORY_ALIGNMENT - 1);
+}
+
+int edfSetAllocator(const EdfAllocator* allocator) {
+    if (allocator && (!allocator->alloc || !allocator->free)) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_allocator_mutex);
+    if (allocator) {
+        g_allocator = *allocator;
+    } else {
+        g_allocator.alloc     = defaultAlloc;
+        g_allocator.free      = defaultFree;
+        g_allocator.user_data = NULL;
+    }
+    return 0;
+}
+
+void* edfAllocAligned(size_t size) {
+    EdfAllocator allocator = currentAllocator();
+    return allocator.alloc(std::max(size, (size_t)1), EDF_MEMORY_ALIGNMENT, allocator.user_data);
+}
+
+void edfFreeAligned(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    EdfAllocator allocator = currentAllocator();
+    allocator.free(ptr, allocator.user_data);
+}
+
+struct EdfArenaBlock {
+    unsigned char* data;
+    size_t         size;
+    size_t         used;
+};
+
+struct EdfArena {
+    std::vector<EdfArenaBlock> blocks;
+    size_t                     used;
+    size_t                     peak;
+
+    size_t capacity() const {
+        size_t capacity = 0;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            capacity += blocks[b].size;
+        }
+        return capacity;
+    }
+
+    bool addBlock(size_t size) {
+        EdfArenaBlock block;
+        block.data = (unsigned char*)edfAllocAligned(size);
+        block.size = size;
+        block.used = 0;
+        if (!block.data) {
+            return false;
+        }
+        blocks.push_back(block);
+        return true;
+    }
+
+    void freeBlocks() {
+        for (size_t b = 0; b < blocks.size(); b++) {
+            edfFreeAligned(blocks[b].data);
+        }
+        blocks.clear();
+    }
+
+    bool owns(const void* ptr) const {
+        const unsigned char* p = (const unsigned char*)ptr;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            if (p >= blocks[b].data && p < blocks[b].data + blocks[b].size) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+int edfCreateArena(size_t capacity, void** arena) {
+    if (!arena || capacity == 0) {
+        return -1;
+    }
+    EdfArena* state = new EdfArena();
+    state->used     = 0;
+    state->peak     = 0;
+    if (!state->addBlock(alignUp(capacity))) {
+        delete state;
+        return -2;
+    }
+    *arena = state;
+    return 0;
+}
+
+void edfFreeArena(void** arena) {
+    if (!arena || !*arena) {
+        return;
+    }
+    EdfArena* state = (EdfArena*)*arena;
+    if (g_thread_arena == state) {
+        g_thread_arena = NULL;
+    }
+    state->freeBlocks();
+    delete state;
+    *arena = NULL;
+}
+
+void* edfArenaAlloc(void* arena, size_t size) {
+    if (!arena) {
+        return NULL;
+    }
+    EdfArena* state = (EdfArena*)arena;
+    size            = alignUp(std::max(size, (size_t)1));
+    EdfArenaBlock* block = state->blocks.empty() ? NULL : &state->blocks.back();
+    if (!block || block->size - block->used < size) {
+        // Grow geometrically so that a frame needs few extra blocks before the next reset merges them.
+        if (!state->addBlock(std::max(size, state->capacity()))) {
+            return NULL;
+        }
+        block = &state->blocks.back();
+    }
+    void* ptr = block->data + block->used;
+    block->used += size;
+    state->used += size;
+    state->peak = std::max(state->peak, state->used);
+    return ptr;
+}
+
+void edfArenaReset(void* arena) {
+    if (!arena) {
+        return;
+    }
+    EdfArena* state = (EdfArena*)arena;
+    if (state->blocks.size() > 1) {
+        // Replace the blocks by one block fitting the whole frame.
+        size_t capacity = state->capacity();
+        state->freeBlocks();
+        state->addBlock(capacity);
+    }
+    for (size_t b = 0; b < state->blocks.size(); b++) {
+        state->blocks[b].used = 0;
+    }
+    state->used = 0;
+}
+
+int edfArenaGetStats(const void* arena, EdfArenaStats* stats) {
+    if (!arena || !stats) {
+        return -1;
+    }
+    const EdfArena* state = (const EdfArena*)arena;
+    stats->capacity       = state->capacity();
+    stats->used           = state->used;
+    stats->peak           = state->peak;
+    stats->num_blocks     = (unsigned int)state->blocks.size();
+    return 0;
+}
+
+void edfSetThreadArena(void* arena) {
+    g_thread_arena = arena;
+}
+
+void* edfAllocScratch(size_t size) {
+    if (g_thread_arena) {
+        return edfArenaAlloc(g_thread_arena, size);
+    }
+    return edfAllocAligned(size);
+}
+
+void edfFreeScratch(void* ptr) {
+    if (!ptr || (g_thread_arena && ((EdfArena*)g_thread_arena)->owns(ptr))) {
+        // Arena memory is released by edfArenaReset.
+        return;
+    }
+    edfFreeAligned(ptr);
+}
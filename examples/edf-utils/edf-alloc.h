@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include <stddef.h>
+
+// Allocation callbacks. The returned memory must be aligned to the given alignment (a power of two, at least
+// EDF_MEMORY_ALIGNMENT), NULL is returned on failure. The free function accepts NULL.
+typedef void* (*fcn_edfAllocCallback)(size_t size, size_t alignment, void* user_data);
+typedef void  (*fcn_edfFreeCallback)(void* ptr, void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfAllocator                                        //
+//////////////////////////////////////////////////////////////
+// EdfAllocator represents the memory allocator used by     //
+// the Eyedentify utilities (edf-utils) for all their       //
+// descriptor, image and scratch buffers.                   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    fcn_edfAllocCallback alloc;          // allocation function
+    fcn_edfFreeCallback  free;           // free function
+    void*                user_data;      // user data passed to the functions, e.g. a memory pool
+} EdfAllocator;
+
+//////////////////////////////////////////////////////////////
+//      EdfArenaStats                                       //
+//////////////////////////////////////////////////////////////
+// EdfArenaStats contains the memory counters of one arena. //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    size_t capacity;                     // byte size of the arena blocks
+    size_t used;                         // bytes allocated since the last reset
+    size_t peak;                         // maximal used bytes since the arena creation
+    unsigned int num_blocks;             // number of blocks, 1 once the arena fits the largest frame
+} EdfArenaStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfSetAllocator                                                                                               //
+//      Sets the process-wide allocator of the Eyedentify utilities, e.g. a huge page pool or a NUMA-local arena.   //
+//      Set it before any other utility call, memory allocated by the previous allocator must be freed first.       //
+//      The SDK library itself allocates by its own allocator.                                                      //
+//                                                                                                                  //
+//      input:          allocator - pointer to the allocator, NULL restores the default aligned malloc/free         //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfSetAllocator(const EdfAllocator* allocator);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAllocAligned, edfFreeAligned                                                                               //
+//      Allocates / frees memory aligned to EDF_MEMORY_ALIGNMENT using the allocator set by edfSetAllocator.        //
+//                                                                                                                  //
+//      return value:   edfAllocAligned: pointer to the memory, NULL on failure                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void* edfAllocAligned(size_t size);
+void  edfFreeAligned(void* ptr);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCreateArena, edfFreeArena                                                                                  //
+//      Creates / frees a bump allocator for per-frame scratch memory. Memory allocated from the arena is not       //
+//      freed one by one but all at once by edfArenaReset, typically at the end of the frame. When a frame does     //
+//      not fit, the arena allocates another block and merges all blocks into one at the next reset.                //
+//      An arena is used by one thread at a time.                                                                   //
+//                                                                                                                  //
+//      input:          capacity - initial byte size of the arena                                                   //
+//      output:         arena    - pointer to the arena                                                             //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 on memory allocation failure                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfCreateArena(size_t capacity, void** arena);
+void edfFreeArena(void** arena);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfArenaAlloc, edfArenaReset, edfArenaGetStats                                                                //
+//      Allocates EDF_MEMORY_ALIGNMENT aligned memory from the arena / releases all memory of the arena /           //
+//      returns the arena counters.                                                                                 //
+//                                                                                                                  //
+//      return value:   edfArenaAlloc: pointer to the memory, NULL on failure                                       //
+//                      edfArenaGetStats: 0 on success, -1 on invalid arguments                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void* edfArenaAlloc(void* arena, size_t size);
+void  edfArenaReset(void* arena);
+int   edfArenaGetStats(const void* arena, EdfArenaStats* stats);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfSetThreadArena                                                                                             //
+//      Sets the arena used for the per-call scratch memory of the utilities called by the current thread           //
+//      (edfAllocScratch). Long-lived buffers (indexes, galleries, batches) never use the arena.                    //
+//                                                                                                                  //
+//      input:          arena - pointer to the arena, NULL to use the allocator set by edfSetAllocator              //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfSetThreadArena(void* arena);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAllocScratch, edfFreeScratch                                                                               //
+//      Allocates / frees per-call scratch memory from the arena of the current thread if set, from the allocator   //
+//      set by edfSetAllocator otherwise. edfFreeScratch must be called by the thread that allocated the memory,    //
+//      the arena of the thread must not be changed or reset in between.                                            //
+//                                                                                                                  //
+//      return value:   edfAllocScratch: pointer to the memory, NULL on failure                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void* edfAllocScratch(size_t size);
+void  edfFreeScratch(void* ptr);
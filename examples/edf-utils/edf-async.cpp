@@ -0,0 +1,334 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-async.h"
+
+#include "edf-thread-pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+struct AsyncRequest;
+
+struct EdfAsyncEngine {
+    const EdfAPI*                  edf_api;
+    void*                          module_state;
+    void*                          lane;
+    EdfRecognizeConfig             recognize_config;
+    EdfCropImageConfig             crop_config;
+    EdfClassifyConfig              classify_config;
+    fcn_edfAsyncCallback           callback;
+    void*                          callback_data;
+    int                            event_fd;
+    std::mutex                     mutex;
+    std::condition_variable        queue_cond;   // signals edfAsyncPoll about new completions
+    std::deque<EdfAsyncCompletion> queue;
+    std::vector<AsyncRequest*>     ready;        // heap of the submitted requests, see runsAfter
+    unsigned long long             next_ticket;
+    unsigned int                   num_pending;
+};
+
+struct AsyncRequest {
+    EdfAsyncEngine*                       engine;
+    unsigned long long                    ticket;
+    const ERImage*                        image;
+    EdfCropParams                         crop_params;  // points to the copies below
+    std::vector<double>                   rows;
+    std::vector<double>                   cols;
+    std::vector<double>                   values;
+    void*                                 user_data;
+    void*                                 awaitable;    // EdfAsyncRecognize of edfAsyncSubmitAwait
+    int                                   priority;
+    unsigned long long                    deadline_us;  // 0 if none
+    std::chrono::steady_clock::time_point submitted;
+};
+
+// Heap order of the ready requests: higher priority first, then earliest deadline first, then submission order.
+static bool runsAfter(const AsyncRequest* a, const AsyncRequest* b) {
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    if (a->deadline_us != b->deadline_us) {
+        return a->deadline_us == 0 || (b->deadline_us != 0 && a->deadline_us > b->deadline_us);
+    }
+    return a->ticket > b->ticket;
+}
+
+static unsigned long long clockUs(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.;
+}
+
+static void deliver(AsyncRequest* request, EdfAsyncCompletion& completion);
+
+// Lane task, one per submitted request. Runs the first ready request, not necessarily the one it was submitted for.
+static void runRequest(void* user_data) {
+    EdfAsyncEngine* engine  = (EdfAsyncEngine*)user_data;
+    AsyncRequest*   request = NULL;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex);
+        std::pop_heap(engine->ready.begin(), engine->ready.end(), runsAfter);
+        request = engine->ready.back();
+        engine->ready.pop_back();
+    }
+
+    EdfAsyncCompletion completion;
+    memset(&completion, 0, sizeof(EdfAsyncCompletion));
+    completion.ticket    = request->ticket;
+    completion.user_data = request->user_data;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    completion.queue_ms = elapsedMs(request->submitted, start);
+    if (request->deadline_us != 0 && clockUs(start) >= request->deadline_us) {
+        // Too late to be useful, skip the recognition.
+        completion.code = EDF_ERROR_DEADLINE_EXCEEDED;
+    } else {
+        completion.code   = edfRecognize(engine->edf_api, request->image, &request->crop_params,
+                                         engine->module_state, &completion.result, &engine->recognize_config);
+        completion.run_ms = elapsedMs(start, std::chrono::steady_clock::now());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex);
+        engine->num_pending--;
+    }
+    deliver(request, completion);
+    delete request;
+}
+
+#if defined(__cplusplus) && __cplusplus >= 202002L && __has_include(<coroutine>)
+static void resumeAwaitable(void* awaitable, EdfAsyncCompletion& completion) {
+    EdfAsyncRecognize* recognize = (EdfAsyncRecognize*)awaitable;
+    recognize->completion        = completion;
+    recognize->handle.resume();
+}
+#else
+static void resumeAwaitable(void* awaitable, EdfAsyncCompletion& completion) {
+    (void)awaitable;
+    (void)completion;
+}
+#endif
+
+static void deliver(AsyncRequest* request, EdfAsyncCompletion& completion) {
+    EdfAsyncEngine* engine = request->engine;
+    if (request->awaitable) {
+        resumeAwaitable(request->awaitable, completion);
+        return;
+    }
+    if (engine->callback) {
+        engine->callback(&completion, engine->callback_data);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex);
+        engine->queue.push_back(completion);
+    }
+    engine->queue_cond.notify_one();
+#if defined(__linux__)
+    uint64_t one     = 1;
+    ssize_t  written = write(engine->event_fd, &one, sizeof(one));
+    (void)written;
+#endif
+}
+
+int edfAsyncCreate(const EdfAPI* edf_api, void* pool, void* module_state, const EdfAsyncConfig* config, void** engine) {
+    if (!edf_api || !pool || !module_state || !engine) {
+        return -1;
+    }
+    EdfAsyncEngine* state = new EdfAsyncEngine();
+    state->edf_api        = edf_api;
+    state->module_state   = module_state;
+    state->lane           = NULL;
+    memset(&state->recognize_config, 0, sizeof(EdfRecognizeConfig));
+    if (config && config->recognize_config) {
+        state->recognize_config = *config->recognize_config;
+        if (config->recognize_config->crop_config) {
+            state->crop_config                  = *config->recognize_config->crop_config;
+            state->recognize_config.crop_config = &state->crop_config;
+        }
+        if (config->recognize_config->classify_config) {
+            state->classify_config                  = *config->recognize_config->classify_config;
+            state->recognize_config.classify_config = &state->classify_config;
+        }
+    }
+    state->callback      = config ? config->callback : NULL;
+    state->callback_data = config ? config->callback_data : NULL;
+    state->next_ticket   = 1;
+    state->num_pending   = 0;
+    state->event_fd      = -1;
+#if defined(__linux__)
+    state->event_fd = eventfd(0, EFD_NONBLOCK | EFD_SEMAPHORE | EFD_CLOEXEC);
+    if (state->event_fd < 0) {
+        delete state;
+        return -2;
+    }
+#endif
+    // One task at a time, the module state must not be used by several threads at once.
+    edfThreadPoolAddLane(pool, config ? config->priority : 0, 1, &state->lane);
+    *engine = state;
+    return 0;
+}
+
+void edfAsyncFree(void** engine) {
+    if (!engine || !*engine) {
+        return;
+    }
+    EdfAsyncEngine* state = (EdfAsyncEngine*)*engine;
+    edfThreadPoolRemoveLane(&state->lane);
+    for (size_t i = 0; i < state->queue.size(); i++) {
+        edfFreeRecognizeResult(state->edf_api, &state->queue[i].result, state->module_state);
+    }
+#if defined(__linux__)
+    close(state->event_fd);
+#endif
+    delete state;
+    *engine = NULL;
+}
+
+static int submitRequest(EdfAsyncEngine* engine, const ERImage* image, const EdfCropParams* crop_params,
+                         void* user_data, const EdfAsyncRequestConfig* config, void* awaitable,
+                         unsigned long long* ticket) {
+    AsyncRequest* request = new AsyncRequest();
+    request->engine       = engine;
+    request->image        = image;
+    request->rows.assign(crop_params->points.rows, crop_params->points.rows + crop_params->points.length);
+    request->cols.assign(crop_params->points.cols, crop_params->points.cols + crop_params->points.length);
+    request->values.assign(crop_params->values.values, crop_params->values.values + crop_params->values.length);
+    request->crop_params               = *crop_params;
+    request->crop_params.points.rows   = request->rows.empty() ? NULL : &request->rows[0];
+    request->crop_params.points.cols   = request->cols.empty() ? NULL : &request->cols[0];
+    request->crop_params.values.values = request->values.empty() ? NULL : &request->values[0];
+    request->user_data                 = user_data;
+    request->awaitable                 = awaitable;
+    request->priority                  = config ? config->priority : 0;
+    request->deadline_us               = config ? config->deadline_us : 0;
+    request->submitted                 = std::chrono::steady_clock::now();
+    // The lane task is submitted under the mutex before the request is queued, so the task finds a request to pop
+    // and a failed submission leaves nothing to undo. Lane tasks take the mutex without holding the pool one.
+    unsigned long long request_ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex);
+        request_ticket  = engine->next_ticket++;
+        request->ticket = request_ticket;
+        if (edfThreadPoolSubmit(engine->lane, runRequest, engine) != 0) {
+            delete request;
+            return -2;
+        }
+        engine->num_pending++;
+        engine->ready.push_back(request);
+        std::push_heap(engine->ready.begin(), engine->ready.end(), runsAfter);
+    }
+    // The request may be deleted already, use the copy of the ticket.
+    if (ticket) {
+        *ticket = request_ticket;
+    }
+    return 0;
+}
+
+int edfAsyncSubmit(void* engine, const ERImage* image, const EdfCropParams* crop_params, void* user_data,
+                   unsigned long long* ticket) {
+    if (!engine || !image || !crop_params) {
+        return -1;
+    }
+    return submitRequest((EdfAsyncEngine*)engine, image, crop_params, user_data, NULL, NULL, ticket);
+}
+
+int edfAsyncSubmitEx(void* engine, const ERImage* image, const EdfCropParams* crop_params, void* user_data,
+                     const EdfAsyncRequestConfig* config, unsigned long long* ticket) {
+    if (!engine || !image || !crop_params) {
+        return -1;
+    }
+    return submitRequest((EdfAsyncEngine*)engine, image, crop_params, user_data, config, NULL, ticket);
+}
+
+unsigned long long edfAsyncClockUs() {
+    return clockUs(std::chrono::steady_clock::now());
+}
+
+int edfAsyncPoll(void* engine, EdfAsyncCompletion* completion, int timeout_ms) {
+    if (!engine || !completion) {
+        return -1;
+    }
+    EdfAsyncEngine*              state = (EdfAsyncEngine*)engine;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (timeout_ms < 0) {
+        state->queue_cond.wait(lock, [state]() { return !state->queue.empty(); });
+    } else {
+        state->queue_cond.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                   [state]() { return !state->queue.empty(); });
+    }
+    if (state->queue.empty()) {
+        return -2;
+    }
+    *completion = state->queue.front();
+    state->queue.pop_front();
+    return 0;
+}
+
+int edfAsyncEventFd(const void* engine) {
+    return engine ? ((const EdfAsyncEngine*)engine)->event_fd : -1;
+}
+
+int edfAsyncWaitAll(void* engine) {
+    if (!engine) {
+        return -1;
+    }
+    return edfThreadPoolWait(((EdfAsyncEngine*)engine)->lane);
+}
+
+unsigned int edfAsyncNumPending(const void* engine) {
+    if (!engine) {
+        return 0;
+    }
+    EdfAsyncEngine*             state = (EdfAsyncEngine*)engine;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->num_pending;
+}
+
+void edfAsyncFreeCompletion(void* engine, EdfAsyncCompletion* completion) {
+    if (!engine || !completion) {
+        return;
+    }
+    EdfAsyncEngine* state = (EdfAsyncEngine*)engine;
+    edfFreeRecognizeResult(state->edf_api, &completion->result, state->module_state);
+}
+
+#if defined(__cplusplus) && __cplusplus >= 202002L && __has_include(<coroutine>)
+int edfAsyncSubmitAwait(void* engine, const ERImage* image, const EdfCropParams* crop_params,
+                        EdfAsyncRecognize* awaitable) {
+    if (!engine || !image || !crop_params || !awaitable) {
+        return -1;
+    }
+    return submitRequest((EdfAsyncEngine*)engine, image, crop_params, NULL, NULL, awaitable, NULL);
+}
+#endif
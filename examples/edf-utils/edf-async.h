@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-recognize.h"
+
+//////////////////////////////////////////////////////////////
+//      EdfAsyncCompletion                                  //
+//////////////////////////////////////////////////////////////
+// EdfAsyncCompletion represents one finished request.      //
+// The result is owned by the receiver of the completion,   //
+// free it using edfAsyncFreeCompletion.                    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned long long ticket;             // ticket returned by edfAsyncSubmit
+    int                code;               // edfRecognize return code, EDF_ERROR_DEADLINE_EXCEEDED if not run in time
+    EdfRecognizeResult result;             // recognition result, empty on failure
+    void*              user_data;          // user data passed to edfAsyncSubmit
+    double             queue_ms;           // time from the submission to the start of the recognition
+    double             run_ms;             // recognition time
+} EdfAsyncCompletion;
+
+// Completion callback, called by a pool worker thread. Copy the completion to keep the result beyond the call.
+// Do not free the engine from the callback.
+typedef void (*fcn_edfAsyncCallback)(EdfAsyncCompletion* completion, void* callback_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfAsyncConfig                                      //
+//////////////////////////////////////////////////////////////
+// EdfAsyncConfig represents the configuration parameters   //
+// of the asynchronous recognition engine.                  //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfRecognizeConfig*  recognize_config; // recognition chain configuration (can be NULL), copied
+    int                  priority;         // priority of the engine lane in the thread pool
+    fcn_edfAsyncCallback callback;         // completion callback (can be NULL to use the completion queue)
+    void*                callback_data;    // data passed to the callback
+} EdfAsyncConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncCreate, edfAsyncFree                                                                                  //
+//      Creates the asynchronous recognition engine of the module state running on a lane of the thread pool        //
+//      (edf-thread-pool.h) / waits for the submitted requests, frees the undelivered completions and the engine.   //
+//      The engine is the only user of the module state, requests run one at a time, the higher priority first,     //
+//      the earliest deadline first within a priority (see edfAsyncSubmitEx), in the submission order otherwise.    //
+//      The engine attaches a lane to the pool, free all engines of the pool before edfThreadPoolFree.              //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      pool         - pointer to the thread pool                                                   //
+//                      module_state - pointer to the module state                                                  //
+//                      config       - engine configuration (can be NULL)                                           //
+//      output:         engine       - pointer to the engine                                                        //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the event descriptor cannot be created         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfAsyncCreate(const EdfAPI* edf_api, void* pool, void* module_state, const EdfAsyncConfig* config, void** engine);
+void edfAsyncFree(void** engine);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncSubmit                                                                                                //
+//      Submits the recognition of one vehicle and returns immediately. The crop parameters are copied, the image   //
+//      must stay valid until the completion. The completion is passed to the callback of the engine if set, it     //
+//      is queued for edfAsyncPoll otherwise. The function is thread-safe.                                          //
+//                                                                                                                  //
+//      input:          engine      - pointer to the engine                                                         //
+//                      image       - pointer to the input image                                                    //
+//                      crop_params - parameters for the input image alignment (LP or MMRBOX, see edf_type_mmr.h)   //
+//                      user_data   - user data returned in the completion                                          //
+//      output:         ticket      - ticket of the request (can be NULL)                                           //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the engine is being freed                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfAsyncSubmit(void* engine, const ERImage* image, const EdfCropParams* crop_params, void* user_data,
+                   unsigned long long* ticket);
+
+//////////////////////////////////////////////////////////////
+//      EdfAsyncRequestConfig                               //
+//////////////////////////////////////////////////////////////
+// EdfAsyncRequestConfig represents the scheduling          //
+// parameters of one request.                               //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    int                priority;           // priority within the engine, higher runs first, 0 DEFAULT
+    unsigned long long deadline_us;        // absolute deadline on the edfAsyncClockUs clock, 0 for none DEFAULT
+} EdfAsyncRequestConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncSubmitEx, edfAsyncClockUs                                                                             //
+//      Submits the request like edfAsyncSubmit with a priority and a deadline / returns the current time of the    //
+//      monotonic clock of the deadlines in microseconds. Requests still queued at their deadline are not run and   //
+//      complete with EDF_ERROR_DEADLINE_EXCEEDED and an empty result, so stale frames do not delay fresh ones.     //
+//                                                                                                                  //
+//      input:          engine      - pointer to the engine                                                         //
+//                      image       - pointer to the input image                                                    //
+//                      crop_params - parameters for the input image alignment (LP or MMRBOX, see edf_type_mmr.h)   //
+//                      user_data   - user data returned in the completion                                          //
+//                      config      - scheduling parameters (can be NULL)                                           //
+//      output:         ticket      - ticket of the request (can be NULL)                                           //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the engine is being freed                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfAsyncSubmitEx(void* engine, const ERImage* image, const EdfCropParams* crop_params, void* user_data,
+                     const EdfAsyncRequestConfig* config, unsigned long long* ticket);
+unsigned long long edfAsyncClockUs();
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncPoll                                                                                                  //
+//      Takes the oldest completion from the completion queue of an engine without a callback.                      //
+//                                                                                                                  //
+//      input:          engine     - pointer to the engine                                                          //
+//                      timeout_ms - maximal wait, 0 not to wait, negative to wait until a completion is queued     //
+//      output:         completion - pointer to the EdfAsyncCompletion structure to fill                            //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if no completion is queued within the timeout     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfAsyncPoll(void* engine, EdfAsyncCompletion* completion, int timeout_ms);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncEventFd                                                                                               //
+//      Returns the Linux eventfd readable while the completion queue is not empty, to wait for completions in      //
+//      poll/epoll together with other descriptors. Each queued completion adds 1 to the counter (semaphore mode),  //
+//      read 8 bytes before each edfAsyncPoll. Do not close the descriptor.                                         //
+//                                                                                                                  //
+//      return value:   file descriptor, -1 on invalid arguments or on other platforms                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfAsyncEventFd(const void* engine);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncWaitAll, edfAsyncNumPending                                                                           //
+//      Waits until all submitted requests are finished / returns the number of submitted unfinished requests.      //
+//                                                                                                                  //
+//      return value:   edfAsyncWaitAll: 0 on success, -1 on invalid arguments                                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int          edfAsyncWaitAll(void* engine);
+unsigned int edfAsyncNumPending(const void* engine);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfAsyncFreeCompletion                                                                                        //
+//      Frees the result of the completion.                                                                         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfAsyncFreeCompletion(void* engine, EdfAsyncCompletion* completion);
+
+#if defined(__cplusplus) && __cplusplus >= 202002L && __has_include(<coroutine>)
+#include <coroutine>
+
+struct EdfAsyncRecognize;
+
+// Submits the request of the awaitable bypassing the callback and the completion queue of the engine, the coroutine
+// of the awaitable is resumed on the completion.
+int edfAsyncSubmitAwait(void* engine, const ERImage* image, const EdfCropParams* crop_params,
+                        EdfAsyncRecognize* awaitable);
+
+//////////////////////////////////////////////////////////////
+//      EdfAsyncRecognize                                   //
+//////////////////////////////////////////////////////////////
+// EdfAsyncRecognize is the C++20 awaitable of one request: //
+//   EdfAsyncCompletion c =                                 //
+//       co_await EdfAsyncRecognize(engine, &image, &p);    //
+// The coroutine resumes on the pool worker thread, free    //
+// the result using edfAsyncFreeCompletion.                 //
+//////////////////////////////////////////////////////////////
+struct EdfAsyncRecognize {
+    void*                   engine;
+    const ERImage*          image;
+    const EdfCropParams*    crop_params;
+    EdfAsyncCompletion      completion;
+    std::coroutine_handle<> handle;
+
+    EdfAsyncRecognize(void* engine_, const ERImage* image_, const EdfCropParams* crop_params_)
+        : engine(engine_), image(image_), crop_params(crop_params_), completion(), handle() {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle_) {
+        handle   = handle_;
+        int code = edfAsyncSubmitAwait(engine, image, crop_params, this);
+        if (code != 0) {
+            // Resume immediately when the submission failed.
+            completion.code = code;
+            return false;
+        }
+        // The request may have completed and the coroutine resumed already, do not touch this anymore.
+        return true;
+    }
+
+    EdfAsyncCompletion await_resume() noexcept { return completion; }
+};
+#endif
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-buffers.h"
+
+#include "edf-alloc.h"
+
+#include <edf_type_mmr.h>
+
+#include <map>
+#include <mutex>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+// Size of the blank probe image used by edfDescriptorSize
+#define EDF_PROBE_WIDTH  640
+#define EDF_PROBE_HEIGHT 480
+
+// Descriptor sizes by module state and model version.
+static std::mutex                                                   g_sizes_mutex;
+static std::map<std::pair<const void*, unsigned int>, unsigned int> g_sizes;
+
+// Crops the probe image with the MMRBOX parameters, then with the LP parameters.
+static int cropProbe(const EdfAPI* edf_api, void* module_state, ERImage* crop) {
+    std::vector<unsigned char> data((size_t)EDF_PROBE_WIDTH * EDF_PROBE_HEIGHT * 3, 128);
+    ERImage image;
+    memset(&image, 0, sizeof(ERImage));
+    int code = edf_api->erImageAllocateAndWrap(&image, EDF_PROBE_WIDTH, EDF_PROBE_HEIGHT, ER_IMAGE_COLORMODEL_BGR,
+                                               ER_IMAGE_DATATYPE_UCHAR, &data[0], EDF_PROBE_WIDTH * 3);
+    if (code != 0) {
+        return code;
+    }
+    double box_rows[EDF_MMRBOX_CROP_POINTS] = {EDF_PROBE_HEIGHT / 4, EDF_PROBE_HEIGHT * 3 / 4};
+    double box_cols[EDF_MMRBOX_CROP_POINTS] = {EDF_PROBE_WIDTH / 4, EDF_PROBE_WIDTH * 3 / 4};
+    EdfCropParams params;
+    params.points.length = EDF_MMRBOX_CROP_POINTS;
+    params.points.rows   = box_rows;
+    params.points.cols   = box_cols;
+    params.values.length = EDF_MMRBOX_CROP_VALUES;
+    params.values.values = NULL;
+    code = edf_api->edfCropImage(&image, &params, module_state, crop, NULL);
+    if (code != 0) {
+        double lp_rows[EDF_MMR_CROP_POINTS]   = {EDF_PROBE_HEIGHT * 3 / 4};
+        double lp_cols[EDF_MMR_CROP_POINTS]   = {EDF_PROBE_WIDTH / 2};
+        double lp_values[EDF_MMR_CROP_VALUES] = {200.0, 0.0};  // px/m, rotation
+        params.points.length = EDF_MMR_CROP_POINTS;
+        params.points.rows   = lp_rows;
+        params.points.cols   = lp_cols;
+        params.values.length = EDF_MMR_CROP_VALUES;
+        params.values.values = lp_values;
+        code = edf_api->edfCropImage(&image, &params, module_state, crop, NULL);
+    }
+    edf_api->erImageFree(&image);
+    return code;
+}
+
+int edfDescriptorSize(const EdfAPI* edf_api, void* module_state, unsigned int* size) {
+    if (!edf_api || !module_state || !size) {
+        return -1;
+    }
+    std::pair<const void*, unsigned int> key(module_state, edf_api->edfModelVersion(module_state));
+    {
+        std::lock_guard<std::mutex> lock(g_sizes_mutex);
+        std::map<std::pair<const void*, unsigned int>, unsigned int>::iterator it = g_sizes.find(key);
+        if (it != g_sizes.end()) {
+            *size = it->second;
+            return 0;
+        }
+    }
+    ERImage crop;
+    memset(&crop, 0, sizeof(ERImage));
+    int code = cropProbe(edf_api, module_state, &crop);
+    if (code != 0) {
+        return code;
+    }
+    EdfDescriptor descriptor;
+    memset(&descriptor, 0, sizeof(EdfDescriptor));
+    code = edf_api->edfComputeDesc(&crop, module_state, &descriptor, NULL);
+    edf_api->edfFreeCropImage(module_state, &crop);
+    if (code != 0) {
+        return code;
+    }
+    *size = descriptor.size;
+    edf_api->edfFreeDesc(&descriptor);
+    std::lock_guard<std::mutex> lock(g_sizes_mutex);
+    g_sizes[key] = *size;
+    return 0;
+}
+
+int edfCropImageInto(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                     ERImage* crop, EdfCropImageConfig* config) {
+    if (!edf_api || !image_in || !params || !module_state || !crop) {
+        return -1;
+    }
+    ERImage tmp;
+    memset(&tmp, 0, sizeof(ERImage));
+    int code = edf_api->edfCropImage(image_in, params, module_state, &tmp, config);
+    if (code != 0) {
+        return code;
+    }
+    if (!crop->data || crop->width != tmp.width || crop->height != tmp.height ||
+        crop->color_model != tmp.color_model || crop->data_type != tmp.data_type) {
+        edf_api->erImageFree(crop);
+        memset(crop, 0, sizeof(ERImage));
+        code = edf_api->erImageAllocate(crop, tmp.width, tmp.height, tmp.color_model, tmp.data_type);
+    }
+    if (code == 0) {
+        size_t row_size = (size_t)tmp.width * tmp.depth;
+        for (unsigned int row = 0; row < tmp.height; row++) {
+            memcpy(crop->row_data[row], tmp.row_data[row], row_size);
+        }
+    }
+    edf_api->edfFreeCropImage(module_state, &tmp);
+    return code;
+}
+
+int edfComputeDescInto(const EdfAPI* edf_api, const ERImage* img, const void* module_state, EdfDescriptor* descriptor,
+                       unsigned int capacity, EdfComputeDescConfig* config) {
+    if (!edf_api || !img || !module_state || !descriptor || !descriptor->data || (config && config->batch_size > 1)) {
+        return -1;
+    }
+    EdfDescriptor tmp;
+    memset(&tmp, 0, sizeof(EdfDescriptor));
+    int code = edf_api->edfComputeDesc(img, module_state, &tmp, config);
+    if (code != 0) {
+        return code;
+    }
+    if (tmp.size > capacity) {
+        code = -2;
+    } else {
+        memcpy(descriptor->data, tmp.data, tmp.size);
+        descriptor->size    = tmp.size;
+        descriptor->version = tmp.version;
+    }
+    edf_api->edfFreeDesc(&tmp);
+    return code;
+}
+
+int edfCreateClassifyBuffer(unsigned int num_values, size_t num_chars, EdfClassifyBuffer* buffer) {
+    if (!buffer || num_values == 0) {
+        return -1;
+    }
+    memset(buffer, 0, sizeof(EdfClassifyBuffer));
+    buffer->values = (EdfClassifyResultValue*)edfAllocAligned(num_values * sizeof(EdfClassifyResultValue));
+    buffer->chars  = (char*)edfAllocAligned(num_chars + 1);
+    if (!buffer->values || !buffer->chars) {
+        edfFreeClassifyBuffer(buffer);
+        return -2;
+    }
+    buffer->capacity_values = num_values;
+    buffer->capacity_chars  = num_chars;
+    buffer->result.values   = buffer->values;
+    return 0;
+}
+
+void edfFreeClassifyBuffer(EdfClassifyBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+    edfFreeAligned(buffer->values);
+    edfFreeAligned(buffer->chars);
+    memset(buffer, 0, sizeof(EdfClassifyBuffer));
+}
+
+int edfClassifyInto(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, EdfClassifyBuffer* buffer,
+                    EdfClassifyConfig* config) {
+    if (!edf_api || !desc || !module_state || !buffer || !buffer->values) {
+        return -1;
+    }
+    buffer->result.num_values = 0;
+    EdfClassifyResult* tmp = NULL;
+    int code = edf_api->edfClassify(desc, module_state, &tmp, config);
+    if (code != 0) {
+        return code;
+    }
+    size_t num_chars = 0;
+    for (unsigned int i = 0; i < tmp->num_values; i++) {
+        num_chars += tmp->values[i].task_name_length + tmp->values[i].class_name_length;
+    }
+    if (tmp->num_values > buffer->capacity_values || num_chars > buffer->capacity_chars) {
+        edf_api->edfFreeClassifyResult(&tmp, module_state);
+        return -2;
+    }
+    char* chars = buffer->chars;
+    for (unsigned int i = 0; i < tmp->num_values; i++) {
+        const EdfClassifyResultValue& src = tmp->values[i];
+        EdfClassifyResultValue&       dst = buffer->values[i];
+        dst = src;
+        dst.task_name = chars;
+        memcpy(chars, src.task_name, src.task_name_length);
+        chars += src.task_name_length;
+        dst.class_name = chars;
+        memcpy(chars, src.class_name, src.class_name_length);
+        chars += src.class_name_length;
+    }
+    buffer->result.num_values = tmp->num_values;
+    buffer->result.values     = buffer->values;
+    edf_api->edfFreeClassifyResult(&tmp, module_state);
+    return 0;
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    COPY COST                                                                                                     //
+//      The *Into functions do not make the SDK calls allocation-free. The library still allocates its own crop,    //
+//      descriptor and classification result on every call, the result is copied to the caller-owned memory and the //
+//      library memory is freed. The steady state is therefore not allocation-free and every call is slower than    //
+//      the plain SDK call by the copy. Use them when the caller needs to own the result memory, e.g. to keep it in //
+//      preallocated pools, not to save allocations.                                                                //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////
+//      EdfClassifyBuffer                                   //
+//////////////////////////////////////////////////////////////
+// EdfClassifyBuffer is a caller-owned classification       //
+// result block of a fixed capacity. The result strings     //
+// point into the chars storage of the buffer, they are     //
+// not null terminated, use the name lengths.               //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfClassifyResult       result;          // classification result, values point into the buffer
+    EdfClassifyResultValue* values;          // storage of capacity_values values
+    unsigned int            capacity_values;
+    char*                   chars;           // storage of capacity_chars name characters
+    size_t                  capacity_chars;
+} EdfClassifyBuffer;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfDescriptorSize                                                                                             //
+//      Returns the byte size of the descriptors computed by the module. The size is measured once per module       //
+//      state by cropping and describing a blank probe image (MMRBOX or LP crop parameters, whichever the module    //
+//      accepts) and cached afterwards. The function is thread-safe for different module states.                    //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state                                                  //
+//      output:         size         - descriptor byte size                                                         //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, edfCropImage or edfComputeDesc error code otherwise  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfDescriptorSize(const EdfAPI* edf_api, void* module_state, unsigned int* size);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCropImageInto                                                                                              //
+//      edfCropImage writing to a caller-owned crop. Zero the crop before the first call, it is allocated by        //
+//      erImageAllocate on the first call and reused by next calls while the crop size and format do not change.    //
+//      Free it by erImageFree. See edfCropImage for the description of the other arguments.                        //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, edfCropImage or erImageAllocate error code otherwise //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCropImageInto(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                     ERImage* crop, EdfCropImageConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfComputeDescInto                                                                                            //
+//      edfComputeDesc writing to a caller-owned descriptor. descriptor->data must point to a buffer of capacity    //
+//      bytes (e.g. allocated once by edfAllocDesc with the size from edfDescriptorSize), the size and the version  //
+//      of the descriptor are set. Batches are not supported, config->batch_size must be at most 1.                 //
+//      See edfComputeDesc for the description of the other arguments.                                              //
+//                                                                                                                  //
+//      input:          capacity - byte capacity of descriptor->data                                                //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the capacity is too small,                     //
+//                      edfComputeDesc error code otherwise                                                         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfComputeDescInto(const EdfAPI* edf_api, const ERImage* img, const void* module_state, EdfDescriptor* descriptor,
+                       unsigned int capacity, EdfComputeDescConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCreateClassifyBuffer, edfFreeClassifyBuffer                                                                //
+//      Allocates / frees the classification result block for at most num_values values with at most num_chars      //
+//      characters of all task and class names together. The storage is allocated by edfAllocAligned (see           //
+//      edf-alloc.h).                                                                                               //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 on memory allocation failure                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfCreateClassifyBuffer(unsigned int num_values, size_t num_chars, EdfClassifyBuffer* buffer);
+void edfFreeClassifyBuffer(EdfClassifyBuffer* buffer);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfClassifyInto                                                                                               //
+//      edfClassify writing to a caller-owned result block, buffer->result holds the result. The result is valid    //
+//      until the next call with the same buffer and must not be freed by edfFreeClassifyResult.                    //
+//      See edfClassify for the description of the other arguments.                                                 //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the capacity of the buffer is too small,       //
+//                      edfClassify error code otherwise                                                            //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfClassifyInto(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, EdfClassifyBuffer* buffer,
+                    EdfClassifyConfig* config);
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-cascade.h"
+
+#include "edf-class-table.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct EdfCascade {
+    void*              fast_state;
+    void*              prec_state;
+    EdfRecognizeConfig recognize_config;
+    EdfCropImageConfig crop_config;
+    EdfClassifyConfig  classify_config;
+    float              score_threshold;
+    std::string        task_name;        // empty to gate all tasks
+    std::mutex         mutex;
+    EdfCascadeStats    stats;
+};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+           1000.;
+}
+
+// Returns the top score of the gated task, the lowest top score of all tasks if no task is set.
+static float gatedScore(const EdfCascade* cascade, const EdfClassifyResult* result) {
+    // Values are not sorted for num_top_scores -1, take the maximum of each task.
+    std::vector<std::pair<std::string, float> > tops;
+    for (unsigned int i = 0; i < result->num_values; i++) {
+        const EdfClassifyResultValue& value = result->values[i];
+        std::string task(value.task_name, value.task_name_length);
+        if (!cascade->task_name.empty() && task != cascade->task_name) {
+            continue;
+        }
+        size_t t = 0;
+        while (t < tops.size() && tops[t].first != task) {
+            t++;
+        }
+        if (t == tops.size()) {
+            tops.push_back(std::make_pair(task, value.score));
+        } else {
+            tops[t].second = std::max(tops[t].second, value.score);
+        }
+    }
+    if (tops.empty()) {
+        // Nothing to gate by, e.g. no values returned.
+        return FLT_MAX;
+    }
+    float score = FLT_MAX;
+    for (size_t t = 0; t < tops.size(); t++) {
+        score = std::min(score, tops[t].second);
+    }
+    return score;
+}
+
+int edfCreateCascade(const EdfAPI* edf_api, void* fast_state, void* prec_state, const EdfCascadeConfig* config,
+                     void** cascade) {
+    if (!edf_api || !fast_state || !prec_state || !config || !cascade) {
+        return -1;
+    }
+    if (config->task_name) {
+        // gatedScore returns FLT_MAX for a task missing in the result, such a cascade would never escalate.
+        EdfClassTable table;
+        int           code = edfGetClassTable(edf_api, fast_state, &table);
+        if (code != 0) {
+            return code;
+        }
+        int task = edfFindClassTask(&table, config->task_name, (unsigned int)strlen(config->task_name));
+        edfFreeClassTable(&table);
+        if (task < 0) {
+            return -2;
+        }
+    }
+    EdfCascade* state = new EdfCascade();
+    state->fast_state = fast_state;
+    state->prec_state = prec_state;
+    memset(&state->recognize_config, 0, sizeof(EdfRecognizeConfig));
+    if (config->recognize_config) {
+        // Keep own copies of the nested configurations, the caller's ones may not outlive the cascade.
+        state->recognize_config = *config->recognize_config;
+        if (config->recognize_config->crop_config) {
+            state->crop_config                  = *config->recognize_config->crop_config;
+            state->recognize_config.crop_config = &state->crop_config;
+        }
+        if (config->recognize_config->classify_config) {
+            state->classify_config                  = *config->recognize_config->classify_config;
+            state->recognize_config.classify_config = &state->classify_config;
+        }
+    }
+    state->score_threshold = config->score_threshold;
+    state->task_name       = config->task_name ? config->task_name : "";
+    memset(&state->stats, 0, sizeof(EdfCascadeStats));
+    *cascade = state;
+    return 0;
+}
+
+void edfFreeCascade(void** cascade) {
+    if (!cascade || !*cascade) {
+        return;
+    }
+    delete (EdfCascade*)*cascade;
+    *cascade = NULL;
+}
+
+int edfCascadeRecognize(const EdfAPI* edf_api, void* cascade, const ERImage* image, EdfCropParams* crop_params,
+                        EdfCascadeResult* result) {
+    if (!edf_api || !cascade || !image || !crop_params || !result) {
+        return -1;
+    }
+    EdfCascade* state = (EdfCascade*)cascade;
+    memset(result, 0, sizeof(EdfCascadeResult));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int code = edfRecognize(edf_api, image, crop_params, state->fast_state, &result->result, &state->recognize_config);
+    result->fast_ms      = elapsedMs(start);
+    result->module_state = state->fast_state;
+    if (code != 0) {
+        return code;
+    }
+    result->fast_score = gatedScore(state, result->result.classify_result);
+
+    if (result->fast_score < state->score_threshold) {
+        // The FAST result is kept until the PREC model succeeds, it is returned if the PREC model fails.
+        EdfRecognizeResult prec_result;
+        start = std::chrono::steady_clock::now();
+        code  = edfRecognize(edf_api, image, crop_params, state->prec_state, &prec_result, &state->recognize_config);
+        result->prec_ms   = elapsedMs(start);
+        result->escalated = 1;
+        if (code == 0) {
+            edfFreeRecognizeResult(edf_api, &result->result, state->fast_state);
+            result->result       = prec_result;
+            result->module_state = state->prec_state;
+        } else {
+            result->prec_code = code;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->stats.num_calls++;
+    state->stats.num_escalated += result->escalated;
+    state->stats.num_prec_failed += result->prec_code != 0;
+    state->stats.fast_ms += result->fast_ms;
+    state->stats.prec_ms += result->prec_ms;
+    return 0;
+}
+
+void edfFreeCascadeResult(const EdfAPI* edf_api, EdfCascadeResult* result) {
+    if (!edf_api || !result) {
+        return;
+    }
+    edfFreeRecognizeResult(edf_api, &result->result, result->module_state);
+    memset(result, 0, sizeof(EdfCascadeResult));
+}
+
+int edfCascadeGetStats(const void* cascade, EdfCascadeStats* stats) {
+    if (!cascade || !stats) {
+        return -1;
+    }
+    EdfCascade*                 state = (EdfCascade*)cascade;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    *stats = state->stats;
+    return 0;
+}
+
+int edfCascadeResetStats(void* cascade) {
+    if (!cascade) {
+        return -1;
+    }
+    EdfCascade*                 state = (EdfCascade*)cascade;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    memset(&state->stats, 0, sizeof(EdfCascadeStats));
+    return 0;
+}
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-recognize.h"
+
+//////////////////////////////////////////////////////////////
+//      EdfCascadeConfig                                    //
+//////////////////////////////////////////////////////////////
+// EdfCascadeConfig represents the configuration            //
+// parameters of the FAST -> PREC model cascade.            //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfRecognizeConfig* recognize_config; // recognition chain configuration of both models (can be NULL)
+    float score_threshold;                // the PREC model is run when the gated score of the FAST model is lower
+    const char* task_name;                // task whose top score is gated, e.g. "MODEL" (null terminated), must be
+                                          // a task of the FAST model. Set to NULL to gate the lowest top score of
+                                          // all tasks. DEFAULT
+} EdfCascadeConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfCascadeResult                                    //
+//////////////////////////////////////////////////////////////
+// EdfCascadeResult represents the result of one cascade    //
+// call. Free it using edfFreeCascadeResult.                //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfRecognizeResult result;            // result of the PREC model if it succeeded, of the FAST model otherwise
+    void*  module_state;                  // module state of the model of the result
+    int    escalated;                     // 1 if the PREC model was run, 0 otherwise
+    int    prec_code;                     // edfRecognize error code of the PREC model, 0 if it succeeded or not run
+    float  fast_score;                    // gated score of the FAST model
+    double fast_ms;                       // FAST model chain time
+    double prec_ms;                       // PREC model chain time, 0 if not escalated
+} EdfCascadeResult;
+
+//////////////////////////////////////////////////////////////
+//      EdfCascadeStats                                     //
+//////////////////////////////////////////////////////////////
+// EdfCascadeStats contains the counters of all calls of    //
+// one cascade.                                             //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned long long num_calls;         // number of successful calls
+    unsigned long long num_escalated;     // number of calls escalated to the PREC model
+    unsigned long long num_prec_failed;   // number of escalated calls returning the FAST result as the PREC failed
+    double fast_ms;                       // total FAST model chain time
+    double prec_ms;                       // total PREC model chain time
+} EdfCascadeStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCreateCascade, edfFreeCascade                                                                              //
+//      Creates / frees the cascade of a fast and a precise model of the same task set, e.g. the *_FAST_2024Q2.dat  //
+//      and *_PREC_2024Q2.dat models. The module states are owned by the caller and must outlive the cascade.       //
+//      The gated task is checked against the class table of the fast model (edf-class-table.h), a task missing in  //
+//      the model would never be escalated.                                                                         //
+//                                                                                                                  //
+//      input:          edf_api    - pointer to the linked Eyedentify API                                           //
+//                      fast_state - module state of the fast model                                                 //
+//                      prec_state - module state of the precise model                                              //
+//                      config     - cascade configuration, copied                                                  //
+//      output:         cascade    - pointer to the cascade                                                         //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the task is not a task of the fast model,      //
+//                      edfGetClassTable error code otherwise                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfCreateCascade(const EdfAPI* edf_api, void* fast_state, void* prec_state, const EdfCascadeConfig* config,
+                      void** cascade);
+void edfFreeCascade(void** cascade);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCascadeRecognize                                                                                           //
+//      Runs edfRecognize with the fast model and, when the top score of the gated task (the lowest top score of    //
+//      all tasks if no task is set) is below the threshold, again with the precise model. The precise result is    //
+//      returned when the precise model succeeds, the fast result otherwise (with prec_code set and counted in      //
+//      num_prec_failed). The counters of the cascade are updated under a lock, concurrent calls with one cascade   //
+//      are allowed as far as the module states allow them.                                                         //
+//                                                                                                                  //
+//      input:          edf_api     - pointer to the linked Eyedentify API                                          //
+//                      cascade     - pointer to the cascade                                                        //
+//                      image       - pointer to the input image                                                    //
+//                      crop_params - parameters for the input image alignment (LP or MMRBOX, see edf_type_mmr.h)   //
+//      output:         result      - pointer to the EdfCascadeResult structure to fill                             //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, edfRecognize error code of the fast model otherwise  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCascadeRecognize(const EdfAPI* edf_api, void* cascade, const ERImage* image, EdfCropParams* crop_params,
+                        EdfCascadeResult* result);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeCascadeResult                                                                                          //
+//      Frees the result created by edfCascadeRecognize.                                                            //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeCascadeResult(const EdfAPI* edf_api, EdfCascadeResult* result);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCascadeGetStats, edfCascadeResetStats                                                                      //
+//      Returns / resets the escalation and failure counts and the per-stage times of all calls of the cascade.     //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCascadeGetStats(const void* cascade, EdfCascadeStats* stats);
+int edfCascadeResetStats(void* cascade);
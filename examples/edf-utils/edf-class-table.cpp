@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-class-table.h"
+
+#include "edf-buffers.h"
+
+#include <algorithm>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct ClassRecord {
+    unsigned int task;
+    int          class_id;
+    size_t       class_name;             // offset in the names storage
+    unsigned int class_name_length;
+
+    bool operator<(const ClassRecord& other) const {
+        return task != other.task ? task < other.task : class_id < other.class_id;
+    }
+};
+
+static bool sameClass(const ClassRecord& a, const ClassRecord& b) {
+    return a.task == b.task && a.class_id == b.class_id;
+}
+
+static bool entryIdLess(const EdfClassTableEntry& entry, int class_id) {
+    return entry.class_id < class_id;
+}
+
+// Fills the table from the classification result with all classes of all tasks.
+static void buildTable(const EdfClassifyResult* result, EdfClassTable* table) {
+    std::string              names;
+    std::vector<std::string> task_list;
+    std::vector<size_t>      task_names;     // offsets in names
+    std::vector<ClassRecord> records;
+    for (unsigned int i = 0; i < result->num_values; i++) {
+        const EdfClassifyResultValue& value = result->values[i];
+        std::string  task_name(value.task_name, value.task_name_length);
+        unsigned int task = (unsigned int)(std::find(task_list.begin(), task_list.end(), task_name) -
+                                           task_list.begin());
+        if (task == task_list.size()) {
+            task_list.push_back(task_name);
+            task_names.push_back(names.size());
+            names.append(value.task_name, value.task_name_length);
+            names.push_back('\0');
+        }
+        ClassRecord record;
+        record.task              = task;
+        record.class_id          = value.class_id;
+        record.class_name        = names.size();
+        record.class_name_length = value.class_name_length;
+        names.append(value.class_name, value.class_name_length);
+        names.push_back('\0');
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end());
+    records.erase(std::unique(records.begin(), records.end(), sameClass), records.end());
+
+    table->names = new char[names.size() + 1];
+    memcpy(table->names, names.c_str(), names.size() + 1);
+    table->num_tasks = (unsigned int)task_names.size();
+    table->tasks     = new EdfClassTableTask[task_names.size() + 1];
+    for (unsigned int t = 0; t < table->num_tasks; t++) {
+        table->tasks[t].name        = table->names + task_names[t];
+        table->tasks[t].name_length = (unsigned int)task_list[t].size();
+        table->tasks[t].first_entry = 0;
+        table->tasks[t].num_classes = 0;
+    }
+    table->num_entries = (unsigned int)records.size();
+    table->entries     = new EdfClassTableEntry[records.size() + 1];
+    for (unsigned int i = 0; i < table->num_entries; i++) {
+        const ClassRecord&  record = records[i];
+        EdfClassTableTask&  task   = table->tasks[record.task];
+        EdfClassTableEntry& entry  = table->entries[i];
+        if (task.num_classes == 0) {
+            task.first_entry = i;
+        }
+        task.num_classes++;
+        entry.task_name         = task.name;
+        entry.task_name_length  = task.name_length;
+        entry.class_name        = table->names + record.class_name;
+        entry.class_name_length = record.class_name_length;
+        entry.class_id          = record.class_id;
+        entry.task_index        = record.task;
+    }
+}
+
+int edfGetClassTable(const EdfAPI* edf_api, void* module_state, EdfClassTable* table) {
+    if (!edf_api || !module_state || !table) {
+        return -1;
+    }
+    memset(table, 0, sizeof(EdfClassTable));
+    unsigned int size = 0;
+    int code = edfDescriptorSize(edf_api, module_state, &size);
+    if (code != 0) {
+        return code;
+    }
+    EdfDescriptor desc;
+    memset(&desc, 0, sizeof(EdfDescriptor));
+    edf_api->edfAllocDesc(&desc, size, edf_api->edfModelVersion(module_state));
+    memset(desc.data, 0, size);
+
+    EdfClassifyConfig config;
+    config.use_dependency_rules = 1;
+    config.num_top_scores       = -1;
+    EdfClassifyResult* result   = NULL;
+    code = edf_api->edfClassify(&desc, module_state, &result, &config);
+    edf_api->edfFreeDesc(&desc);
+    if (code != 0) {
+        return code;
+    }
+    buildTable(result, table);
+    table->model_version = edf_api->edfModelVersion(module_state);
+    edf_api->edfFreeClassifyResult(&result, module_state);
+    return 0;
+}
+
+void edfFreeClassTable(EdfClassTable* table) {
+    if (!table) {
+        return;
+    }
+    delete[] table->tasks;
+    delete[] table->entries;
+    delete[] table->names;
+    memset(table, 0, sizeof(EdfClassTable));
+}
+
+int edfFindClassTask(const EdfClassTable* table, const char* name, unsigned int name_length) {
+    if (!table || !name) {
+        return -1;
+    }
+    for (unsigned int t = 0; t < table->num_tasks; t++) {
+        if (table->tasks[t].name_length == name_length && memcmp(table->tasks[t].name, name, name_length) == 0) {
+            return (int)t;
+        }
+    }
+    return -1;
+}
+
+const EdfClassTableEntry* edfFindClassEntry(const EdfClassTable* table, unsigned int task_index, int class_id) {
+    if (!table || task_index >= table->num_tasks) {
+        return NULL;
+    }
+    const EdfClassTableTask&  task  = table->tasks[task_index];
+    const EdfClassTableEntry* first = table->entries + task.first_entry;
+    const EdfClassTableEntry* last  = first + task.num_classes;
+    const EdfClassTableEntry* entry = std::lower_bound(first, last, class_id, entryIdLess);
+    return entry != last && entry->class_id == class_id ? entry : NULL;
+}
+
+// Returns the class table entry of the result value, task is the task of the previous value.
+static const EdfClassTableEntry* findValueEntry(const EdfClassTable* table, const EdfClassifyResultValue& value,
+                                                int* task) {
+    // Results list the values task by task, look the task up only when it changes.
+    if (*task < 0 || table->tasks[*task].name_length != value.task_name_length ||
+        memcmp(table->tasks[*task].name, value.task_name, value.task_name_length) != 0) {
+        *task = edfFindClassTask(table, value.task_name, value.task_name_length);
+    }
+    return *task < 0 ? NULL : edfFindClassEntry(table, *task, value.class_id);
+}
+
+int edfClassifyFlat(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, const EdfClassTable* table,
+                    EdfClassifyFlatValue* values, unsigned int capacity, unsigned int* num_values,
+                    EdfClassifyConfig* config) {
+    if (!edf_api || !desc || !table || !values || !num_values) {
+        return -1;
+    }
+    *num_values               = 0;
+    EdfClassifyResult* result = NULL;
+    int code = edf_api->edfClassify(desc, module_state, &result, config);
+    if (code != 0) {
+        return code;
+    }
+    if (result->num_values > capacity) {
+        code = -2;
+    }
+    int task = -1;
+    for (unsigned int i = 0; code == 0 && i < result->num_values; i++) {
+        const EdfClassifyResultValue& value = result->values[i];
+        const EdfClassTableEntry*     entry = findValueEntry(table, value, &task);
+        if (!entry) {
+            code = -3;
+            break;
+        }
+        values[i].entry      = entry;
+        values[i].task_index = entry->task_index;
+        values[i].class_id   = value.class_id;
+        values[i].score      = value.score;
+    }
+    if (code == 0) {
+        *num_values = result->num_values;
+    }
+    edf_api->edfFreeClassifyResult(&result, module_state);
+    return code;
+}
+
+int edfClassifyScores(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, const EdfClassTable* table,
+                      float* scores, unsigned int num_scores, EdfClassifyConfig* config) {
+    if (!edf_api || !desc || !table || !scores) {
+        return -1;
+    }
+    if (num_scores < table->num_entries) {
+        return -2;
+    }
+    EdfClassifyConfig all_config;
+    all_config.use_dependency_rules = config ? config->use_dependency_rules : 0;
+    all_config.num_top_scores       = -1;
+    EdfClassifyResult* result       = NULL;
+    int code = edf_api->edfClassify(desc, module_state, &result, &all_config);
+    if (code != 0) {
+        return code;
+    }
+    std::fill(scores, scores + table->num_entries, 0.f);
+    int task = -1;
+    for (unsigned int i = 0; i < result->num_values; i++) {
+        const EdfClassTableEntry* entry = findValueEntry(table, result->values[i], &task);
+        if (!entry) {
+            code = -3;
+            break;
+        }
+        scores[entry - table->entries] = result->values[i].score;
+    }
+    edf_api->edfFreeClassifyResult(&result, module_state);
+    return code;
+}
+
+const EdfClassTableEntry* edfTopClass(const EdfClassTable* table, const float* scores, unsigned int task_index,
+                                      float* score) {
+    if (!table || !scores || task_index >= table->num_tasks || table->tasks[task_index].num_classes == 0) {
+        return NULL;
+    }
+    const EdfClassTableTask& task  = table->tasks[task_index];
+    const float*             first = scores + task.first_entry;
+    const float*             best  = std::max_element(first, first + task.num_classes);
+    if (score) {
+        *score = *best;
+    }
+    return table->entries + task.first_entry + (best - first);
+}
@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfClassTableEntry                                  //
+//////////////////////////////////////////////////////////////
+// EdfClassTableEntry represents one class of one           //
+// classification task of the model. The names are null     //
+// terminated and interned in the class table.              //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    const char*  task_name;              // name of the task
+    unsigned int task_name_length;       // length of the task name
+    const char*  class_name;             // name of the class
+    unsigned int class_name_length;      // length of the class name
+    int          class_id;               // class identificator
+    unsigned int task_index;             // index of the task in EdfClassTable.tasks
+} EdfClassTableEntry;
+
+//////////////////////////////////////////////////////////////
+//      EdfClassTableTask                                   //
+//////////////////////////////////////////////////////////////
+// EdfClassTableTask represents one classification task,    //
+// its classes are num_classes consecutive entries of the   //
+// class table sorted by the class id.                      //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    const char*  name;                   // name of the task
+    unsigned int name_length;            // length of the name
+    unsigned int first_entry;            // index of the first class in EdfClassTable.entries
+    unsigned int num_classes;            // number of classes of the task
+} EdfClassTableTask;
+
+//////////////////////////////////////////////////////////////
+//      EdfClassTable                                       //
+//////////////////////////////////////////////////////////////
+// EdfClassTable is the id to name map of all classes of    //
+// all classification tasks of one model, including the     //
+// tasks without dependency rules (_NODEP name suffix).     //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int        model_version;   // version of the model
+    unsigned int        num_tasks;       // number of tasks
+    EdfClassTableTask*  tasks;           // array of tasks
+    unsigned int        num_entries;     // number of classes of all tasks
+    EdfClassTableEntry* entries;         // array of classes ordered by task and class id
+    char*               names;           // interned storage of all names
+} EdfClassTable;
+
+//////////////////////////////////////////////////////////////
+//      EdfClassifyFlatValue                                //
+//////////////////////////////////////////////////////////////
+// EdfClassifyFlatValue represents one entry of the flat    //
+// classification result. The names are not copied, the     //
+// entry points into the class table.                       //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    const EdfClassTableEntry* entry;     // class of the value in the class table
+    unsigned int task_index;             // index of the task in EdfClassTable.tasks
+    int          class_id;               // class identificator
+    float        score;                  // classification score
+} EdfClassifyFlatValue;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGetClassTable                                                                                              //
+//      Fetches the names of all classes of the model once, typically at startup. The table is built from one       //
+//      edfClassify call returning all classes (num_top_scores -1) of a zero descriptor of the model size given by  //
+//      edfDescriptorSize (edf-buffers.h).                                                                          //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state                                                  //
+//      output:         table        - pointer to the class table, free by edfFreeClassTable                        //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments,                                                      //
+//                      edfDescriptorSize or edfClassify error code otherwise                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfGetClassTable(const EdfAPI* edf_api, void* module_state, EdfClassTable* table);
+void edfFreeClassTable(EdfClassTable* table);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFindClassTask, edfFindClassEntry                                                                           //
+//      Returns the index of the task of the given name / the class table entry of the given task and class id.     //
+//                                                                                                                  //
+//      return value:   edfFindClassTask: index of the task, -1 if not found                                        //
+//                      edfFindClassEntry: pointer to the entry, NULL if not found                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int                       edfFindClassTask(const EdfClassTable* table, const char* name, unsigned int name_length);
+const EdfClassTableEntry* edfFindClassEntry(const EdfClassTable* table, unsigned int task_index, int class_id);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfClassifyFlat                                                                                               //
+//      edfClassify returning the class ids and scores into a caller-owned array, the names point into the class    //
+//      table, so that no result is allocated or copied by the caller. The library result is freed before return.   //
+//      See edfClassify for the description of the other arguments.                                                 //
+//                                                                                                                  //
+//      input:          table      - class table of the module from edfGetClassTable                                //
+//                      capacity   - number of values of the values array                                           //
+//      output:         values     - array of the result values                                                     //
+//                      num_values - number of the result values                                                    //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the capacity is too small,                     //
+//                      -3 if a value is not in the class table, edfClassify error code otherwise                   //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfClassifyFlat(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, const EdfClassTable* table,
+                    EdfClassifyFlatValue* values, unsigned int capacity, unsigned int* num_values,
+                    EdfClassifyConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfClassifyScores                                                                                             //
+//      Classifies the descriptor and writes the dense score vectors of all tasks into a caller-owned array, the    //
+//      score of the class table entry i is written to scores[i], i.e. task t occupies tasks[t].num_classes         //
+//      scores from tasks[t].first_entry. Scores of the tasks not returned by edfClassify (e.g. the _NODEP tasks    //
+//      when use_dependency_rules is 0) are set to 0. The vectors can be summed over the frames of a track and      //
+//      the fused class picked by edfTopClass. config->num_top_scores is ignored, all classes are returned.         //
+//      See edfClassify for the description of the other arguments.                                                 //
+//                                                                                                                  //
+//      input:          table      - class table of the module from edfGetClassTable                                //
+//                      num_scores - number of scores of the scores array, at least table->num_entries              //
+//      output:         scores     - array of the scores                                                            //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if num_scores is too small,                       //
+//                      -3 if a value is not in the class table, edfClassify error code otherwise                   //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfClassifyScores(const EdfAPI* edf_api, const EdfDescriptor* desc, void* module_state, const EdfClassTable* table,
+                      float* scores, unsigned int num_scores, EdfClassifyConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfTopClass                                                                                                   //
+//      Returns the class of the task with the highest score of the dense score vectors from edfClassifyScores.     //
+//                                                                                                                  //
+//      input:          table      - class table of the module                                                      //
+//                      scores     - array of table->num_entries scores                                             //
+//                      task_index - index of the task in table->tasks                                              //
+//      output:         score      - score of the class (can be NULL)                                               //
+//                                                                                                                  //
+//      return value:   pointer to the class table entry, NULL on invalid arguments                                 //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const EdfClassTableEntry* edfTopClass(const EdfClassTable* table, const float* scores, unsigned int task_index,
+                                      float* score);
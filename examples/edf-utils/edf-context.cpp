@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-context.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct EdfSharedState {
+    const EdfAPI*           edf_api;
+    void*                   module_state;
+    bool                    concurrent_const_calls;
+    // Readers-writer lock: const calls are readers, the others are writers. Waiting writers block new readers.
+    std::mutex              mutex;
+    std::condition_variable cond;
+    unsigned int            num_readers;
+    unsigned int            num_waiting_writers;
+    bool                    writer_active;
+
+    void lockExclusive() {
+        std::unique_lock<std::mutex> lock(mutex);
+        num_waiting_writers++;
+        cond.wait(lock, [this]() { return !writer_active && num_readers == 0; });
+        num_waiting_writers--;
+        writer_active = true;
+    }
+
+    void unlockExclusive() {
+        std::lock_guard<std::mutex> lock(mutex);
+        writer_active = false;
+        cond.notify_all();
+    }
+
+    void lockShared() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return !writer_active && num_waiting_writers == 0; });
+        num_readers++;
+    }
+
+    void unlockShared() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--num_readers == 0) {
+            cond.notify_all();
+        }
+    }
+};
+
+struct EdfContext {
+    EdfSharedState* shared;
+    EdfContextStats stats;
+    bool            held;           // held by edfContextAcquireConst
+    bool            held_exclusive; // held exclusively by edfContextAcquireConst
+};
+
+// Locks the shared module state for a call, accounts the waiting time to the context. Returns true if exclusive.
+static bool lockContext(EdfContext* context, bool const_call) {
+    EdfSharedState* shared    = context->shared;
+    bool            exclusive = !const_call || !shared->concurrent_const_calls;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (exclusive) {
+        shared->lockExclusive();
+    } else {
+        shared->lockShared();
+    }
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    context->stats.num_calls++;
+    context->stats.wait_ms += std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1000.;
+    return exclusive;
+}
+
+static void unlockContext(EdfContext* context, bool exclusive) {
+    if (exclusive) {
+        context->shared->unlockExclusive();
+    } else {
+        context->shared->unlockShared();
+    }
+}
+
+// Holds the shared module state for the scope of one SDK call.
+class ContextGuard {
+public:
+    ContextGuard(EdfContext* context, bool const_call)
+        : context_(context), exclusive_(lockContext(context, const_call)) {}
+
+    ~ContextGuard() { unlockContext(context_, exclusive_); }
+
+private:
+    EdfContext* context_;
+    bool        exclusive_;
+};
+
+int edfCreateSharedState(const EdfAPI* edf_api, void* module_state, const EdfSharedStateConfig* config,
+                         void** shared_state) {
+    if (!edf_api || !module_state || !shared_state) {
+        return -1;
+    }
+    EdfSharedState* state = new EdfSharedState();
+    state->edf_api                = edf_api;
+    state->module_state           = module_state;
+    state->concurrent_const_calls = config && config->concurrent_const_calls == EDF_CONFIG_VALUE_ENABLED;
+    state->num_readers            = 0;
+    state->num_waiting_writers    = 0;
+    state->writer_active          = false;
+    *shared_state = state;
+    return 0;
+}
+
+void edfFreeSharedState(void** shared_state) {
+    if (shared_state && *shared_state) {
+        delete (EdfSharedState*)*shared_state;
+        *shared_state = NULL;
+    }
+}
+
+const void* edfSharedStateModuleState(const void* shared_state) {
+    return shared_state ? ((const EdfSharedState*)shared_state)->module_state : NULL;
+}
+
+int edfSharedStateConcurrent(const void* shared_state) {
+    return shared_state && ((const EdfSharedState*)shared_state)->concurrent_const_calls ? 1 : 0;
+}
+
+int edfCreateContext(void* shared_state, void** context) {
+    if (!shared_state || !context) {
+        return -1;
+    }
+    EdfContext* state = new EdfContext();
+    state->shared          = (EdfSharedState*)shared_state;
+    state->stats.num_calls = 0;
+    state->stats.wait_ms   = 0.0;
+    state->held            = false;
+    state->held_exclusive  = false;
+    *context = state;
+    return 0;
+}
+
+void edfFreeContext(void** context) {
+    if (context && *context) {
+        delete (EdfContext*)*context;
+        *context = NULL;
+    }
+}
+
+const void* edfContextGetModuleState(const void* context) {
+    return context ? ((const EdfContext*)context)->shared->module_state : NULL;
+}
+
+int edfContextGetStats(const void* context, EdfContextStats* stats) {
+    if (!context || !stats) {
+        return -1;
+    }
+    *stats = ((const EdfContext*)context)->stats;
+    return 0;
+}
+
+int edfContextAcquireConst(void* context, const void** module_state) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state || !module_state || state->held) {
+        return -1;
+    }
+    state->held_exclusive = lockContext(state, true);
+    state->held           = true;
+    *module_state         = state->shared->module_state;
+    return 0;
+}
+
+int edfContextReleaseConst(void* context) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state || !state->held) {
+        return -1;
+    }
+    state->held = false;
+    unlockContext(state, state->held_exclusive);
+    return 0;
+}
+
+int edfContextCropImage(void* context, const ERImage* image_in, EdfCropParams* params, ERImage* cropped_image,
+                        EdfCropImageConfig* config) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, false);
+    return state->shared->edf_api->edfCropImage(image_in, params, state->shared->module_state, cropped_image, config);
+}
+
+int edfContextFreeCropImage(void* context, ERImage* cropped_image) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, false);
+    return state->shared->edf_api->edfFreeCropImage(state->shared->module_state, cropped_image);
+}
+
+int edfContextComputeDesc(void* context, const ERImage* img, EdfDescriptor* descriptor, EdfComputeDescConfig* config) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, true);
+    return state->shared->edf_api->edfComputeDesc(img, state->shared->module_state, descriptor, config);
+}
+
+int edfContextCompareDescs(void* context, const EdfDescriptor* desc_A, const EdfDescriptor* desc_B, float* score) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, true);
+    return state->shared->edf_api->edfCompareDescs(desc_A, desc_B, state->shared->module_state, score);
+}
+
+int edfContextClassify(void* context, const EdfDescriptor* desc, EdfClassifyResult** classify_result,
+                       EdfClassifyConfig* config) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, false);
+    return state->shared->edf_api->edfClassify(desc, state->shared->module_state, classify_result, config);
+}
+
+int edfContextFreeClassifyResult(void* context, EdfClassifyResult** classify_result) {
+    EdfContext* state = (EdfContext*)context;
+    if (!state) {
+        return -1;
+    }
+    ContextGuard guard(state, false);
+    return state->shared->edf_api->edfFreeClassifyResult(classify_result, state->shared->module_state);
+}
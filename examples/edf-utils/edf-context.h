@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    THREAD-SAFETY CONTRACT                                                                                        //
+//      The module state returned by edfInitEyedentify is not thread-safe. One module state (and the model          //
+//      weights loaded by it) can be shared by many threads through the shared state created by                     //
+//      edfCreateSharedState. Every thread creates its own execution context using edfCreateContext and calls       //
+//      the edfContext* functions instead of the EdfAPI functions:                                                  //
+//        - edfContextCropImage, edfContextFreeCropImage, edfContextClassify and edfContextFreeClassifyResult       //
+//          take the module state as non-const (void*) and are always run exclusively.                              //
+//        - edfContextComputeDesc and edfContextCompareDescs take the module state as const (const void*).          //
+//          They are run exclusively by default. Set EdfSharedStateConfig.concurrent_const_calls to                 //
+//          EDF_CONFIG_VALUE_ENABLED to run them concurrently with each other, if the used module supports it.      //
+//      The memory used stays the one of a single module state regardless of the number of threads.                 //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////
+//      EdfSharedStateConfig                                //
+//////////////////////////////////////////////////////////////
+// EdfSharedStateConfig represents the configuration        //
+// parameters of the module state shared between threads.   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    int concurrent_const_calls; // Set to  1 to run edfComputeDesc and edfCompareDescs concurrently with each other.
+                                // Set to  0 or -1 to run all calls on the module state exclusively. DEFAULT
+} EdfSharedStateConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfContextStats                                     //
+//////////////////////////////////////////////////////////////
+// EdfContextStats contains the counters of one execution   //
+// context since its creation.                              //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned long long num_calls;      // number of SDK calls made through the context
+    double             wait_ms;        // total time spent waiting for the shared module state
+} EdfContextStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCreateSharedState                                                                                          //
+//      Wraps the module state to be shared by many threads. The module state stays owned by the caller, it must    //
+//      outlive the shared state and must not be used directly while shared.                                        //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state initialized by edfInitEyedentify                 //
+//                      config       - shared state configuration (can be NULL)                                     //
+//      output:         shared_state - pointer to the shared state                                                  //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCreateSharedState(const EdfAPI* edf_api, void* module_state, const EdfSharedStateConfig* config,
+                         void** shared_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeSharedState                                                                                            //
+//      Frees the shared state. All contexts created over it must be freed before. The module state is not freed.   //
+//                                                                                                                  //
+//      input:          shared_state - pointer to the shared state                                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeSharedState(void** shared_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfSharedStateModuleState, edfSharedStateConcurrent                                                           //
+//      Returns the wrapped module state / 1 if concurrent_const_calls is enabled, 0 otherwise.                     //
+//      input:          shared_state - pointer to the shared state                                                  //
+//      return value:   module state or NULL / 1 or 0, NULL or 0 on invalid arguments                               //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const void* edfSharedStateModuleState(const void* shared_state);
+int         edfSharedStateConcurrent(const void* shared_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCreateContext                                                                                              //
+//      Creates a lightweight execution context over the shared state. A context is used by one thread at a time.   //
+//                                                                                                                  //
+//      input:          shared_state - pointer to the shared state                                                  //
+//      output:         context      - pointer to the execution context                                             //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCreateContext(void* shared_state, void** context);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeContext                                                                                                //
+//      Frees the execution context created by edfCreateContext.                                                    //
+//                                                                                                                  //
+//      input:          context - pointer to the execution context                                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeContext(void** context);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfContextGetModuleState                                                                                      //
+//      Returns the module state of the context, e.g. for edfModelVersion.                                          //
+//                                                                                                                  //
+//      input:          context - pointer to the execution context                                                  //
+//                                                                                                                  //
+//      return value:   pointer to the module state, NULL on invalid arguments                                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const void* edfContextGetModuleState(const void* context);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfContextGetStats                                                                                            //
+//      Returns the counters of the execution context.                                                              //
+//                                                                                                                  //
+//      input:          context - pointer to the execution context                                                  //
+//      output:         stats   - pointer to the EdfContextStats structure to fill                                  //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfContextGetStats(const void* context, EdfContextStats* stats);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfContextAcquireConst, edfContextReleaseConst                                                                //
+//      Holds the shared module state for a sequence of const calls (edfComputeDesc, edfCompareDescs) made directly //
+//      through the EdfAPI with the returned module state, e.g. a scan of many gallery rows, so the lock is taken   //
+//      once instead of once per call. The state is held as by one edfContextCompareDescs call (concurrently with   //
+//      other const calls if enabled) and counts as one call in the stats. Only const calls may be made until the   //
+//      release, no other edfContext* call of the same context, and waiting writers are blocked until then.         //
+//                                                                                                                  //
+//      input:          context      - pointer to the execution context                                             //
+//      output:         module_state - module state to pass to the const EdfAPI calls                               //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments or if already held / not held                         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfContextAcquireConst(void* context, const void** module_state);
+int edfContextReleaseConst(void* context);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfContext*                                                                                                   //
+//      Thread-safe counterparts of the EdfAPI functions of the same name, the module state argument is replaced    //
+//      by the execution context. See edf.h for the description of the other arguments and the return values.       //
+//      -1 is returned on invalid arguments.                                                                        //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfContextCropImage(void* context, const ERImage* image_in, EdfCropParams* params, ERImage* cropped_image,
+                        EdfCropImageConfig* config);
+int edfContextFreeCropImage(void* context, ERImage* cropped_image);
+int edfContextComputeDesc(void* context, const ERImage* img, EdfDescriptor* descriptor, EdfComputeDescConfig* config);
+int edfContextCompareDescs(void* context, const EdfDescriptor* desc_A, const EdfDescriptor* desc_B, float* score);
+int edfContextClassify(void* context, const EdfDescriptor* desc, EdfClassifyResult** classify_result,
+                       EdfClassifyConfig* config);
+int edfContextFreeClassifyResult(void* context, EdfClassifyResult** classify_result);
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-crop-batch.h"
+
+#include "edf-alloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Frees the wrapped images from the given index on, the buffers are kept for reuse.
+static void releaseWrapped(const EdfAPI* edf_api, EdfCropBatch* batch, unsigned int first) {
+    for (unsigned int i = first; i < batch->num_wrapped; i++) {
+        edf_api->erImageFree(&batch->images[i]);
+    }
+    if (batch->num_wrapped > first) {
+        batch->num_wrapped = first;
+    }
+}
+
+// Checks if the wrapped image can take the crop without wrapping the buffer again.
+static bool sameLayout(const ERImage* image, const ERImage* crop, const unsigned char* data) {
+    return image->data == data && image->width == crop->width && image->height == crop->height &&
+           image->step == crop->step && image->color_model == crop->color_model && image->data_type == crop->data_type;
+}
+
+int edfCropImageBatch(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, unsigned int num_params,
+                      void* module_state, EdfCropBatch* batch, EdfCropImageConfig* config) {
+    if (!edf_api || !image_in || (!params && num_params > 0) || !module_state || !batch) {
+        return -1;
+    }
+    batch->num_images = 0;
+    if (num_params == 0) {
+        return 0;
+    }
+    if (batch->crops_capacity < num_params) {
+        delete[] batch->crops;
+        batch->crops_capacity = num_params;
+        batch->crops          = new ERImage[num_params];
+    }
+
+    // Crop all vehicles first, the crop size is module dependent.
+    size_t image_stride = 0;
+    int code = 0;
+    unsigned int num_crops = 0;
+    for (; num_crops < num_params; num_crops++) {
+        ERImage* crop = &batch->crops[num_crops];
+        memset(crop, 0, sizeof(ERImage));
+        code = edf_api->edfCropImage(image_in, &params[num_crops], module_state, crop, config);
+        if (code != 0) {
+            break;
+        }
+        size_t size  = (size_t)crop->step * crop->height;
+        size_t round = (size + EDF_MEMORY_ALIGNMENT - 1) / EDF_MEMORY_ALIGNMENT * EDF_MEMORY_ALIGNMENT;
+        if (round > image_stride) {
+            image_stride = round;
+        }
+    }
+
+    if (code == 0 && batch->data_capacity < image_stride * num_params) {
+        // The wrapped images point to the old buffer.
+        releaseWrapped(edf_api, batch, 0);
+        edfFreeAligned(batch->data);
+        batch->data_capacity = image_stride * num_params;
+        batch->data          = (unsigned char*)edfAllocAligned(batch->data_capacity);
+        if (!batch->data) {
+            batch->data_capacity = 0;
+            code = -2;
+        }
+    }
+    if (code == 0 && batch->images_capacity < num_params) {
+        ERImage* images = new ERImage[num_params];
+        if (batch->num_wrapped > 0) {
+            memcpy(images, batch->images, batch->num_wrapped * sizeof(ERImage));
+        }
+        delete[] batch->images;
+        batch->images_capacity = num_params;
+        batch->images          = images;
+    }
+
+    for (unsigned int i = 0; i < num_crops; i++) {
+        ERImage* crop = &batch->crops[i];
+        if (code == 0) {
+            ERImage*       image = &batch->images[i];
+            unsigned char* data  = batch->data + i * image_stride;
+            if (i >= batch->num_wrapped || !sameLayout(image, crop, data)) {
+                releaseWrapped(edf_api, batch, i);
+                memset(image, 0, sizeof(ERImage));
+                code = edf_api->erImageAllocateAndWrap(image, crop->width, crop->height, crop->color_model,
+                                                       crop->data_type, data, crop->step);
+                if (code == 0) {
+                    batch->num_wrapped = i + 1;
+                }
+            }
+            if (code == 0) {
+                for (unsigned int row = 0; row < crop->height; row++) {
+                    memcpy(image->row_data[row], crop->row_data[row], crop->step);
+                }
+            }
+        }
+        edf_api->edfFreeCropImage(module_state, crop);
+    }
+    if (code != 0) {
+        return code;
+    }
+    batch->num_images   = num_crops;
+    batch->image_stride = image_stride;
+    return 0;
+}
+
+void edfFreeCropBatch(const EdfAPI* edf_api, EdfCropBatch* batch) {
+    if (!edf_api || !batch) {
+        return;
+    }
+    releaseWrapped(edf_api, batch, 0);
+    delete[] batch->images;
+    delete[] batch->crops;
+    edfFreeAligned(batch->data);
+    memset(batch, 0, sizeof(EdfCropBatch));
+}
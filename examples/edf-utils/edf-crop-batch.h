@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfCropBatch                                        //
+//////////////////////////////////////////////////////////////
+// EdfCropBatch holds the crops of many vehicles of one     //
+// frame in one contiguous aligned buffer. Zero the         //
+// structure before the first use, it is reused by next     //
+// edfCropImageBatch calls and freed by edfFreeCropBatch.   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int   num_images;           // number of crops in the batch
+    ERImage*       images;               // crops wrapping the buffer, edfComputeDesc input with batch_size = num_images
+    unsigned char* data;                 // buffer with all crops, aligned to EDF_MEMORY_ALIGNMENT
+    size_t         image_stride;         // byte offset between two consecutive crops in data
+    size_t         data_capacity;        // allocated byte size of data
+    unsigned int   images_capacity;      // allocated number of images
+    unsigned int   num_wrapped;          // number of images wrapping the buffer, kept for reuse
+    ERImage*       crops;                // crops of the library, copied to the buffer
+    unsigned int   crops_capacity;       // allocated number of crops
+} EdfCropBatch;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCropImageBatch                                                                                             //
+//      Crops all vehicles of one input image and stores the crops in one contiguous buffer, each crop starts at    //
+//      an EDF_MEMORY_ALIGNMENT aligned offset. The batch images can be passed directly to edfComputeDesc with      //
+//      EdfComputeDescConfig.batch_size = batch->num_images. The buffer, the crop list and the images wrapping the  //
+//      buffer are kept in the batch and reused, the batch allocates nothing for frames with no more vehicles and   //
+//      no larger crops than before. edfCropImage still allocates each crop in the library, the crop is copied to   //
+//      the buffer and freed.                                                                                       //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      image_in     - pointer to the input image                                                   //
+//                      params       - array of num_params crop parameters (LP or MMRBOX, see edf_type_mmr.h)       //
+//                      num_params   - number of vehicles to crop                                                   //
+//                      module_state - pointer to the module state                                                  //
+//                      config       - image cropping configuration (can be NULL)                                   //
+//      output:         batch        - pointer to the batch to fill                                                 //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 on memory allocation failure,                     //
+//                      edfCropImage error code otherwise (the batch is empty)                                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCropImageBatch(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, unsigned int num_params,
+                      void* module_state, EdfCropBatch* batch, EdfCropImageConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeCropBatch                                                                                              //
+//      Frees all buffers of the batch and zeroes the structure.                                                    //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      batch   - pointer to the batch                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeCropBatch(const EdfAPI* edf_api, EdfCropBatch* batch);
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-desc-service.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct DescRequest {
+    const ERImage*                        img;
+    EdfDescriptor*                        descriptor;
+    std::chrono::steady_clock::time_point submitted;
+    int                                   code;
+    bool                                  done;
+};
+
+struct EdfDescService {
+    const EdfAPI*              edf_api;
+    const void*                module_state;
+    unsigned int               max_batch_size;
+    std::chrono::microseconds  max_delay;
+    std::mutex                 mutex;
+    std::condition_variable    queue_cond;     // signals the worker about new requests or stop
+    std::condition_variable    done_cond;      // signals the callers about finished requests
+    std::condition_variable    idle_cond;      // signals edfDescServiceFree about the last caller leaving
+    std::deque<DescRequest*>   queue;
+    unsigned int               num_callers;    // callers inside edfDescServiceCompute using the service
+    bool                       stopping;
+    EdfDescServiceStats        stats;
+    std::thread                worker;
+
+    void run() {
+        std::vector<DescRequest*>  batch;
+        std::vector<ERImage>       crops;
+        std::vector<EdfDescriptor> descriptors;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            queue_cond.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            // Hold the batch open until it is full or the oldest crop waited max_delay.
+            std::chrono::steady_clock::time_point deadline = queue.front()->submitted + max_delay;
+            queue_cond.wait_until(lock, deadline, [this]() { return stopping || queue.size() >= max_batch_size; });
+
+            size_t batch_size = std::min((size_t)max_batch_size, queue.size());
+            batch.assign(queue.begin(), queue.begin() + batch_size);
+            queue.erase(queue.begin(), queue.begin() + batch_size);
+            lock.unlock();
+
+            crops.resize(batch_size);
+            descriptors.assign(batch_size, EdfDescriptor());
+            for (size_t i = 0; i < batch_size; i++) {
+                crops[i] = *batch[i]->img;
+            }
+            EdfComputeDescConfig config;
+            config.batch_size = (unsigned int)batch_size;
+            int code = edf_api->edfComputeDesc(&crops[0], module_state, &descriptors[0], &config);
+
+            lock.lock();
+            for (size_t i = 0; i < batch_size; i++) {
+                batch[i]->code = code;
+                if (code == 0) {
+                    *batch[i]->descriptor = descriptors[i];
+                }
+                batch[i]->done = true;
+            }
+            stats.num_requests += batch_size;
+            stats.num_batches++;
+            stats.max_batch_size = std::max(stats.max_batch_size, (unsigned int)batch_size);
+            done_cond.notify_all();
+        }
+    }
+};
+
+int edfDescServiceCreate(const EdfAPI* edf_api, const void* module_state, const EdfDescServiceConfig* config,
+                         void** service) {
+    if (!edf_api || !edf_api->edfComputeDesc || !module_state || !service) {
+        return -1;
+    }
+    EdfDescService* state = new EdfDescService();
+    state->edf_api        = edf_api;
+    state->module_state   = module_state;
+    state->max_batch_size = (config && config->max_batch_size > 1) ? config->max_batch_size : 1;
+    state->max_delay      = std::chrono::microseconds(config ? config->max_delay_us : 0);
+    state->num_callers    = 0;
+    state->stopping       = false;
+    state->stats.num_requests   = 0;
+    state->stats.num_batches    = 0;
+    state->stats.max_batch_size = 0;
+    state->worker = std::thread(&EdfDescService::run, state);
+    *service = state;
+    return 0;
+}
+
+void edfDescServiceFree(void** service) {
+    if (!service || !*service) {
+        return;
+    }
+    EdfDescService* state = (EdfDescService*)*service;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->queue_cond.notify_all();
+    state->worker.join();
+    {
+        // Callers woken by the last batch may still be reacquiring the mutex in done_cond.wait.
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->idle_cond.wait(lock, [state]() { return state->num_callers == 0; });
+    }
+    delete state;
+    *service = NULL;
+}
+
+int edfDescServiceCompute(void* service, const ERImage* img, EdfDescriptor* descriptor) {
+    EdfDescService* state = (EdfDescService*)service;
+    if (!state || !img || !descriptor) {
+        return -1;
+    }
+    DescRequest request;
+    request.img        = img;
+    request.descriptor = descriptor;
+    request.submitted  = std::chrono::steady_clock::now();
+    request.code       = -1;
+    request.done       = false;
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->stopping) {
+        return -1;
+    }
+    state->num_callers++;
+    state->queue.push_back(&request);
+    if (state->queue.size() == 1 || state->queue.size() >= state->max_batch_size) {
+        state->queue_cond.notify_one();
+    }
+    state->done_cond.wait(lock, [&request]() { return request.done; });
+    if (--state->num_callers == 0 && state->stopping) {
+        // Notified under the lock, the service is deleted only after the lock is released.
+        state->idle_cond.notify_all();
+    }
+    return request.code;
+}
+
+int edfDescServiceGetStats(const void* service, EdfDescServiceStats* stats) {
+    EdfDescService* state = (EdfDescService*)service;
+    if (!state || !stats) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    *stats = state->stats;
+    return 0;
+}
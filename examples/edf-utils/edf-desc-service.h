@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfDescServiceConfig                                //
+//////////////////////////////////////////////////////////////
+// EdfDescServiceConfig represents the configuration        //
+// parameters of the descriptor service, which coalesces    //
+// single crops submitted by many threads into batched      //
+// edfComputeDesc calls.                                    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int max_batch_size;   // Maximal number of crops passed to one edfComputeDesc call (EdfComputeDescConfig.batch_size).
+                                   // Set 0 or 1 to disable batching (required by sdks/modules/edftf2lite-* backend).
+    unsigned int max_delay_us;     // Maximal time in microseconds the oldest waiting crop is held to fill the batch.
+                                   // Set 0 to run the crops waiting at the moment without any delay.
+} EdfDescServiceConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfDescServiceStats                                 //
+//////////////////////////////////////////////////////////////
+// EdfDescServiceStats contains the counters of the         //
+// descriptor service since its creation.                   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned long long num_requests;   // number of computed crops
+    unsigned long long num_batches;    // number of edfComputeDesc calls
+    unsigned int       max_batch_size; // largest batch passed to edfComputeDesc
+} EdfDescServiceStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfDescServiceCreate                                                                                          //
+//      Creates the descriptor service over the module state and starts its worker thread. The worker thread is     //
+//      the only one calling edfComputeDesc on the module state, do not call it from other threads meanwhile.       //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state                                                  //
+//                      config       - service configuration (can be NULL, batching is disabled)                    //
+//      output:         service      - pointer to the service                                                       //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfDescServiceCreate(const EdfAPI* edf_api, const void* module_state, const EdfDescServiceConfig* config,
+                         void** service);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfDescServiceFree                                                                                            //
+//      Stops the worker thread and frees the service. Crops already submitted are computed and the function waits  //
+//      until all their edfDescServiceCompute calls return before the service is freed. Calls starting after the    //
+//      stop return -1, the service pointer must not be used by any call starting after the free.                   //
+//                                                                                                                  //
+//      input:          service - pointer to the service                                                            //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfDescServiceFree(void** service);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfDescServiceCompute                                                                                         //
+//      Submits one crop to the service and waits until its descriptor is computed. The function is thread-safe,    //
+//      crops submitted concurrently are computed together in one batch. The returned descriptor is owned by        //
+//      the caller and must be freed using edfFreeDesc.                                                             //
+//                                                                                                                  //
+//      input:          service    - pointer to the service                                                         //
+//                      img        - registered and aligned image using edfCropImage                                //
+//      output:         descriptor - pointer to a user defined EdfDescriptor structure to fill                      //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments or service stopped, edfComputeDesc error code of the batch otherwise   //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfDescServiceCompute(void* service, const ERImage* img, EdfDescriptor* descriptor);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfDescServiceGetStats                                                                                        //
+//      Returns the counters of the service, num_requests / num_batches is the mean batch size.                     //
+//                                                                                                                  //
+//      input:          service - pointer to the service                                                            //
+//      output:         stats   - pointer to the EdfDescServiceStats structure to fill                              //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfDescServiceGetStats(const void* service, EdfDescServiceStats* stats);
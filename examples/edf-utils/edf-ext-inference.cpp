@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-ext-inference.h"
+
+#include "edf-alloc.h"
+
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+struct EdfExtInference {
+    const EdfAPI*                 edf_api;
+    void*                         module_state;
+    unsigned int                  slot;
+    fcn_edfBatchInferenceCallback inference_callback;
+    void*                         user_data;
+    unsigned int                  output_size;
+    unsigned int                  max_batch_size;
+    unsigned char*                data;          // outputs of max_batch_size crops
+    std::vector<unsigned char*>   outputs;       // aligned output of each crop in data
+    unsigned int                  num_pending;   // outputs computed by the batched callback
+    unsigned int                  next_pending;  // next output consumed by the single-crop callback
+    const ERImage*                pending_crop;  // crop the pending output was computed from
+    unsigned long long            num_fallbacks; // pending outputs not used, see matchesPending
+};
+
+// The library callback has no user context, each adapter is bound to its own callback slot.
+static std::mutex       g_slots_mutex;
+static EdfExtInference* g_slots[EDF_EXT_INFERENCE_MAX_ADAPTERS];
+
+// The library passes either the crop itself or its copy of the same size to the callback, any other image means it
+// runs the network on something else and the precomputed output must not be used.
+static bool matchesPending(const EdfExtInference* adapter, const ERImage* image) {
+    const ERImage* crop = adapter->pending_crop;
+    if (image == crop) {
+        return true;
+    }
+    return image && image->width == crop->width && image->height == crop->height &&
+           image->color_model == crop->color_model && image->data_type == crop->data_type;
+}
+
+static int dispatchInference(unsigned int slot, const ERImage* image, unsigned char* output) {
+    EdfExtInference* adapter = g_slots[slot];
+    if (adapter->next_pending < adapter->num_pending) {
+        // The pending output is offered to the first callback of edfComputeDesc only.
+        adapter->next_pending = adapter->num_pending;
+        if (matchesPending(adapter, image)) {
+            memcpy(output, adapter->outputs[adapter->num_pending - 1], adapter->output_size);
+            return 0;
+        }
+        adapter->num_fallbacks++;
+    }
+    // edfComputeDesc called directly or with an unexpected image, run a batch of one writing to the library buffer.
+    return adapter->inference_callback(image, 1, &output, adapter->output_size, adapter->user_data);
+}
+
+template <unsigned int SLOT>
+static int slotInference(const ERImage* image, unsigned char* output) {
+    return dispatchInference(SLOT, image, output);
+}
+
+static const fcn_edfInferenceCallback g_slot_callbacks[EDF_EXT_INFERENCE_MAX_ADAPTERS] = {
+    slotInference<0>, slotInference<1>, slotInference<2>, slotInference<3>,
+    slotInference<4>, slotInference<5>, slotInference<6>, slotInference<7>};
+
+static void releaseSlot(EdfExtInference* adapter) {
+    std::lock_guard<std::mutex> lock(g_slots_mutex);
+    g_slots[adapter->slot] = NULL;
+}
+
+int edfInitExtInference(const EdfAPI* edf_api, const EdfInitConfig* init_config, const EdfExtInferenceConfig* config,
+                        void** adapter) {
+    if (!edf_api || !edf_api->edfInitEyedentify_ExternalInference || !init_config || !config ||
+        !config->inference_callback || config->output_buffer_size == 0 || !adapter) {
+        return -1;
+    }
+    EdfExtInference* state = new EdfExtInference();
+    state->edf_api            = edf_api;
+    state->module_state       = NULL;
+    state->inference_callback = config->inference_callback;
+    state->user_data          = config->user_data;
+    state->output_size        = config->output_buffer_size;
+    state->max_batch_size     = config->max_batch_size > 0 ? config->max_batch_size : 1;
+    state->num_pending        = 0;
+    state->next_pending       = 0;
+    state->pending_crop       = NULL;
+    state->num_fallbacks      = 0;
+
+    size_t stride = (state->output_size + EDF_MEMORY_ALIGNMENT - 1) / EDF_MEMORY_ALIGNMENT * EDF_MEMORY_ALIGNMENT;
+    state->data   = (unsigned char*)edfAllocAligned(stride * state->max_batch_size);
+    if (!state->data) {
+        delete state;
+        return -3;
+    }
+    for (unsigned int i = 0; i < state->max_batch_size; i++) {
+        state->outputs.push_back(state->data + i * stride);
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_slots_mutex);
+        state->slot = 0;
+        while (state->slot < EDF_EXT_INFERENCE_MAX_ADAPTERS && g_slots[state->slot]) {
+            state->slot++;
+        }
+        if (state->slot == EDF_EXT_INFERENCE_MAX_ADAPTERS) {
+            edfFreeAligned(state->data);
+            delete state;
+            return -2;
+        }
+        g_slots[state->slot] = state;
+    }
+    int code = edf_api->edfInitEyedentify_ExternalInference(init_config, g_slot_callbacks[state->slot],
+                                                            config->output_buffer_size, &state->module_state);
+    if (code != 0) {
+        releaseSlot(state);
+        edfFreeAligned(state->data);
+        delete state;
+        return code;
+    }
+    *adapter = state;
+    return 0;
+}
+
+void edfFreeExtInference(void** adapter) {
+    if (!adapter || !*adapter) {
+        return;
+    }
+    EdfExtInference* state = (EdfExtInference*)*adapter;
+    state->edf_api->edfFreeEyedentify(&state->module_state);
+    releaseSlot(state);
+    edfFreeAligned(state->data);
+    delete state;
+    *adapter = NULL;
+}
+
+void* edfExtInferenceModuleState(const void* adapter) {
+    return adapter ? ((const EdfExtInference*)adapter)->module_state : NULL;
+}
+
+int edfExtInferenceComputeDesc(void* adapter, const ERImage* crops, unsigned int num_crops,
+                               EdfDescriptor* descriptors) {
+    EdfExtInference* state = (EdfExtInference*)adapter;
+    if (!state || !crops || !descriptors || num_crops == 0 || num_crops > state->max_batch_size) {
+        return -1;
+    }
+    int code = state->inference_callback(crops, num_crops, &state->outputs[0], state->output_size, state->user_data);
+    if (code != 0) {
+        return code;
+    }
+    unsigned int i = 0;
+    for (; i < num_crops; i++) {
+        // Bind the output of crop i to the next single-crop callback only.
+        state->num_pending  = i + 1;
+        state->next_pending = i;
+        state->pending_crop = &crops[i];
+        memset(&descriptors[i], 0, sizeof(EdfDescriptor));
+        code = state->edf_api->edfComputeDesc(&crops[i], state->module_state, &descriptors[i], NULL);
+        if (code != 0) {
+            break;
+        }
+        if (state->next_pending != state->num_pending) {
+            // edfComputeDesc did not call the callback, the output was computed in vain.
+            state->num_fallbacks++;
+        }
+    }
+    if (code != 0) {
+        for (unsigned int j = 0; j < i; j++) {
+            state->edf_api->edfFreeDesc(&descriptors[j]);
+        }
+    }
+    state->num_pending  = 0;
+    state->next_pending = 0;
+    state->pending_crop = NULL;
+    return code;
+}
+
+unsigned long long edfExtInferenceNumFallbacks(const void* adapter) {
+    return adapter ? ((const EdfExtInference*)adapter)->num_fallbacks : 0;
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+// Maximal number of external inference adapters existing at once
+#define EDF_EXT_INFERENCE_MAX_ADAPTERS 8
+
+// Batched external inference callback. Runs the inference of num_crops crops and writes the network output of crop i
+// (output_size bytes) to outputs[i]. The outputs of edfExtInferenceComputeDesc are EDF_MEMORY_ALIGNMENT aligned
+// buffers of the adapter, the output of edfComputeDesc called directly is the library buffer. Returns 0 on success.
+typedef int (*fcn_edfBatchInferenceCallback)(const ERImage* crops, unsigned int num_crops,
+                                             unsigned char* const* outputs, unsigned int output_size, void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfExtInferenceConfig                               //
+//////////////////////////////////////////////////////////////
+// EdfExtInferenceConfig represents the configuration       //
+// parameters of the batched external inference adapter.    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    fcn_edfBatchInferenceCallback inference_callback; // batched inference of the user runtime
+    void*        user_data;                           // user context passed to the callback, e.g. a per-thread session
+    unsigned int output_buffer_size;                  // byte size of the network output of one crop
+    unsigned int max_batch_size;                      // maximal number of crops of one edfExtInferenceComputeDesc call
+} EdfExtInferenceConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfInitExtInference                                                                                           //
+//      Initializes the module by edfInitEyedentify_ExternalInference with a batched callback having a user         //
+//      context. The adapter registers one of EDF_EXT_INFERENCE_MAX_ADAPTERS single-crop callbacks forwarding to    //
+//      the batched one and owns the output buffers of max_batch_size crops the user runtime writes into.           //
+//                                                                                                                  //
+//      input:          edf_api     - pointer to the linked Eyedentify API                                          //
+//                      init_config - pointer to the initialization structure                                       //
+//                      config      - adapter configuration                                                         //
+//      output:         adapter     - pointer to the adapter                                                        //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if all adapters are used,                         //
+//                      -3 on memory allocation failure, edfInitEyedentify_ExternalInference error code otherwise   //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfInitExtInference(const EdfAPI* edf_api, const EdfInitConfig* init_config, const EdfExtInferenceConfig* config,
+                        void** adapter);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeExtInference                                                                                           //
+//      Frees the module state and the adapter.                                                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeExtInference(void** adapter);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfExtInferenceModuleState                                                                                    //
+//      Returns the module state of the adapter for the other SDK calls (edfCropImage, edfClassify, ...).           //
+//      edfComputeDesc called directly runs the callback for one crop at a time writing to the library buffer.      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void* edfExtInferenceModuleState(const void* adapter);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfExtInferenceComputeDesc                                                                                    //
+//      Computes the descriptors of the crops with one batched callback call: the callback runs on all crops at     //
+//      once first, then edfComputeDesc runs for each crop and its single-crop callback copies the precomputed      //
+//      output to the library buffer. Must not be called concurrently with the same adapter.                        //
+//      ASSUMPTION: edfComputeDesc calls the inference callback exactly once per crop, with the crop or its copy    //
+//      of the same size, color model and data type. The library does not document it. The adapter checks it on     //
+//      every call: the precomputed output is used only by the first callback of edfComputeDesc of crop i and       //
+//      only if its image matches crops[i], any other callback runs the batched callback for one image again.       //
+//      The results stay correct, edfExtInferenceNumFallbacks counts the outputs computed in vain.                  //
+//                                                                                                                  //
+//      input:          adapter     - pointer to the adapter                                                        //
+//                      crops       - array of crops from edfCropImage                                              //
+//                      num_crops   - number of crops, at most max_batch_size                                       //
+//      output:         descriptors - array of num_crops descriptors to fill, free them by edfFreeDesc              //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, callback or edfComputeDesc error code otherwise      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfExtInferenceComputeDesc(void* adapter, const ERImage* crops, unsigned int num_crops,
+                               EdfDescriptor* descriptors);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfExtInferenceNumFallbacks                                                                                   //
+//      Returns the number of outputs precomputed by edfExtInferenceComputeDesc that edfComputeDesc did not use,    //
+//      a non-zero value means the library breaks the assumption above and the batching does not pay off.           //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long edfExtInferenceNumFallbacks(const void* adapter);
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-gallery.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#define EDF_GALLERY_FSEEK(file_id, offset) _fseeki64(file_id, (__int64)(offset), SEEK_SET)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EDF_GALLERY_FSEEK(file_id, offset) fseeko(file_id, (off_t)(offset), SEEK_SET)
+#endif
+
+static FILE* openFile(const char* path, const char* mode) {
+    FILE* file_id = NULL;
+#if _WIN32 || _WIN64
+    if (fopen_s(&file_id, path, mode) != 0) {
+        file_id = NULL;
+    }
+#else
+    file_id = fopen(path, mode);
+#endif
+    return file_id;
+}
+
+static bool isHeaderValid(const EdfGalleryHeader& header) {
+    return memcmp(header.magic, EDF_GALLERY_MAGIC, sizeof(header.magic)) == 0 &&
+           header.format_version == EDF_GALLERY_FORMAT_VERSION &&
+           header.header_size == EDF_GALLERY_HEADER_SIZE &&
+           header.desc_size > 0 &&
+           header.stride == edfGalleryStride(header.desc_size);
+}
+
+int edfGalleryCreate(const char* path, unsigned int model_version, unsigned int desc_size) {
+    if (!path || desc_size == 0) {
+        return -1;
+    }
+    EdfGalleryHeader header;
+    memset(&header, 0, sizeof(EdfGalleryHeader));
+    memcpy(header.magic, EDF_GALLERY_MAGIC, sizeof(header.magic));
+    header.format_version = EDF_GALLERY_FORMAT_VERSION;
+    header.header_size    = EDF_GALLERY_HEADER_SIZE;
+    header.model_version  = model_version;
+    header.desc_size      = desc_size;
+    header.stride         = edfGalleryStride(desc_size);
+    header.count          = 0;
+
+    FILE* file_id = openFile(path, "wb");
+    if (!file_id) {
+        return -3;
+    }
+    bool written = fwrite(&header, sizeof(EdfGalleryHeader), 1, file_id) == 1;
+    written = (fclose(file_id) == 0) && written;
+    return written ? 0 : -3;
+}
+
+int edfGalleryAppend(const char* path, const EdfDescriptor* descs, unsigned int num_descs) {
+    if (!path || (num_descs > 0 && !descs)) {
+        return -1;
+    }
+    FILE* file_id = openFile(path, "r+b");
+    if (!file_id) {
+        return -3;
+    }
+    EdfGalleryHeader header;
+    if (fread(&header, sizeof(EdfGalleryHeader), 1, file_id) != 1 || !isHeaderValid(header)) {
+        fclose(file_id);
+        return -4;
+    }
+    for (unsigned int i = 0; i < num_descs; i++) {
+        if (descs[i].version != header.model_version || descs[i].size != header.desc_size || !descs[i].data) {
+            fclose(file_id);
+            return -2;
+        }
+    }
+    if (num_descs > 0xFFFFFFFFu - header.count) {
+        fclose(file_id);
+        return -1;
+    }
+
+    // Write the rows behind the last stored descriptor, padded with zeros to the stride.
+    std::vector<unsigned char> row(header.stride, 0);
+    size_t offset = (size_t)EDF_GALLERY_HEADER_SIZE + (size_t)header.count * header.stride;
+    bool written = EDF_GALLERY_FSEEK(file_id, offset) == 0;
+    for (unsigned int i = 0; written && i < num_descs; i++) {
+        memcpy(&row[0], descs[i].data, header.desc_size);
+        written = fwrite(&row[0], header.stride, 1, file_id) == 1;
+    }
+    // Publish the new rows by updating the count only after all rows are stored.
+    written = written && fflush(file_id) == 0;
+    if (written) {
+        header.count += num_descs;
+        written = EDF_GALLERY_FSEEK(file_id, 0) == 0 &&
+                  fwrite(&header, sizeof(EdfGalleryHeader), 1, file_id) == 1;
+    }
+    written = (fclose(file_id) == 0) && written;
+    return written ? 0 : -3;
+}
+
+int edfGalleryOpen(const char* path, EdfGalleryFile* gallery_file) {
+    if (!path || !gallery_file) {
+        return -1;
+    }
+    memset(gallery_file, 0, sizeof(EdfGalleryFile));
+
+#if _WIN32 || _WIN64
+    HANDLE file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return -3;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart < (LONGLONG)EDF_GALLERY_HEADER_SIZE) {
+        CloseHandle(file_handle);
+        return -4;
+    }
+    HANDLE map_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!map_handle) {
+        CloseHandle(file_handle);
+        return -3;
+    }
+    void* map_data = MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!map_data) {
+        CloseHandle(map_handle);
+        CloseHandle(file_handle);
+        return -3;
+    }
+    gallery_file->file_handle = file_handle;
+    gallery_file->map_handle  = map_handle;
+    size_t map_size = (size_t)file_size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -3;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < (off_t)EDF_GALLERY_HEADER_SIZE) {
+        close(fd);
+        return -4;
+    }
+    size_t map_size = (size_t)file_stat.st_size;
+    void* map_data = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after the file descriptor is closed.
+    close(fd);
+    if (map_data == MAP_FAILED) {
+        return -3;
+    }
+#endif
+    gallery_file->map_data = map_data;
+    gallery_file->map_size = map_size;
+
+    const EdfGalleryHeader* header = (const EdfGalleryHeader*)map_data;
+    if (!isHeaderValid(*header) ||
+        map_size < (size_t)EDF_GALLERY_HEADER_SIZE + (size_t)header->count * header->stride) {
+        edfGalleryClose(gallery_file);
+        return -4;
+    }
+    gallery_file->gallery.version   = header->model_version;
+    gallery_file->gallery.desc_size = header->desc_size;
+    gallery_file->gallery.stride    = header->stride;
+    gallery_file->gallery.count     = header->count;
+    gallery_file->gallery.data      = (unsigned char*)map_data + EDF_GALLERY_HEADER_SIZE;
+    return 0;
+}
+
+void edfGalleryClose(EdfGalleryFile* gallery_file) {
+    if (!gallery_file) {
+        return;
+    }
+#if _WIN32 || _WIN64
+    if (gallery_file->map_data) {
+        UnmapViewOfFile(gallery_file->map_data);
+    }
+    if (gallery_file->map_handle) {
+        CloseHandle(gallery_file->map_handle);
+    }
+    if (gallery_file->file_handle) {
+        CloseHandle(gallery_file->file_handle);
+    }
+#else
+    if (gallery_file->map_data) {
+        munmap(gallery_file->map_data, gallery_file->map_size);
+    }
+#endif
+    memset(gallery_file, 0, sizeof(EdfGalleryFile));
+}
+
+int edfGalleryGetDesc(const EdfDescriptorGallery* gallery, unsigned int index, EdfDescriptor* desc) {
+    if (!gallery || !desc || index >= gallery->count) {
+        return -1;
+    }
+    desc->version = gallery->version;
+    desc->size    = gallery->desc_size;
+    desc->data    = gallery->data + (size_t)index * gallery->stride;
+    return 0;
+}
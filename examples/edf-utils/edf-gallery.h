@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+#include <stddef.h>
+
+#include "edf-search.h"
+
+// Gallery file identification, the first 8 bytes of the file
+#define EDF_GALLERY_MAGIC          "EDFGALRY"
+// Version of the gallery file format
+#define EDF_GALLERY_FORMAT_VERSION 1
+// Size of the gallery file header, the first descriptor row starts at this offset
+#define EDF_GALLERY_HEADER_SIZE    64
+
+//////////////////////////////////////////////////////////////
+//      EdfGalleryHeader                                    //
+//////////////////////////////////////////////////////////////
+// EdfGalleryHeader is the header of the gallery file.      //
+// The header is followed by count rows of stride bytes,    //
+// each row holds one descriptor data padded with zeros.    //
+// The stride is a multiple of EDF_MEMORY_ALIGNMENT, so     //
+// rows of a memory mapped gallery stay aligned. All values //
+// are stored in the native byte order.                     //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    char         magic[8];          // EDF_GALLERY_MAGIC
+    unsigned int format_version;    // EDF_GALLERY_FORMAT_VERSION
+    unsigned int header_size;       // EDF_GALLERY_HEADER_SIZE
+    unsigned int model_version;     // version of the model used to create all descriptors (see edfModelVersion)
+    unsigned int desc_size;         // number of bytes of one descriptor
+    unsigned int stride;            // number of bytes of one row, see edfGalleryStride
+    unsigned int count;             // number of descriptors stored in the file
+    unsigned char reserved[EDF_GALLERY_HEADER_SIZE - 32]; // reserved, filled with zeros
+} EdfGalleryHeader;
+
+//////////////////////////////////////////////////////////////
+//      EdfGalleryFile                                      //
+//////////////////////////////////////////////////////////////
+// EdfGalleryFile represents the gallery file mapped to     //
+// the memory by edfGalleryOpen. The gallery member points  //
+// directly to the mapped rows and can be passed to         //
+// edfSearchDescs without any copy.                         //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfDescriptorGallery gallery;   // view of the mapped descriptors
+    void*                map_data;  // pointer to the mapped file
+    size_t               map_size;  // size of the mapped file in bytes
+#if _WIN32 || _WIN64
+    HANDLE               file_handle;
+    HANDLE               map_handle;
+#endif
+} EdfGalleryFile;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryCreate                                                                                              //
+//      Creates an empty gallery file for descriptors of the given model version and size.                          //
+//      An existing file is overwritten.                                                                            //
+//                                                                                                                  //
+//      input:          path          - path to the gallery file                                                    //
+//                      model_version - version of the model (see edfModelVersion)                                  //
+//                      desc_size     - number of bytes of one descriptor                                           //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -3 file could not be written                                          //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfGalleryCreate(const char* path, unsigned int model_version, unsigned int desc_size);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryAppend                                                                                              //
+//      Appends descriptors to the end of the gallery file. The rows are written first and the count in the header  //
+//      is updated afterwards, so an interrupted append leaves the previously stored descriptors valid.             //
+//      Galleries opened by edfGalleryOpen before the append do not see the appended descriptors.                   //
+//                                                                                                                  //
+//      input:          path      - path to the gallery file created by edfGalleryCreate                            //
+//                      descs     - array of descriptors of the gallery model version and size                      //
+//                      num_descs - number of descriptors in the array                                              //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, -3 file could not be written,            //
+//                      -4 file is not a valid gallery                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfGalleryAppend(const char* path, const EdfDescriptor* descs, unsigned int num_descs);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryOpen                                                                                                //
+//      Maps the gallery file read-only to the memory. The descriptors are not read nor copied, the pages are       //
+//      loaded by the operating system on the first access and are shared with other processes mapping the file.    //
+//                                                                                                                  //
+//      input:          path         - path to the gallery file                                                     //
+//      output:         gallery_file - pointer to the EdfGalleryFile structure to fill                              //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -3 file could not be mapped, -4 file is not a valid gallery           //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfGalleryOpen(const char* path, EdfGalleryFile* gallery_file);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryClose                                                                                               //
+//      Unmaps the gallery file previously opened by edfGalleryOpen. The gallery view is invalidated.               //
+//                                                                                                                  //
+//      input:          gallery_file - pointer to the EdfGalleryFile structure                                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfGalleryClose(EdfGalleryFile* gallery_file);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryGetDesc                                                                                             //
+//      Wraps the EdfDescriptor structure over one row of the gallery. No data is copied, do not free the           //
+//      descriptor using edfFreeDesc.                                                                               //
+//                                                                                                                  //
+//      input:          gallery - pointer to the gallery                                                            //
+//                      index   - index of the descriptor in the gallery                                            //
+//      output:         desc    - pointer to the EdfDescriptor structure to wrap over the row                       //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfGalleryGetDesc(const EdfDescriptorGallery* gallery, unsigned int index, EdfDescriptor* desc);
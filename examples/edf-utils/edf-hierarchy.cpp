@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-hierarchy.h"
+
+#include <chrono>
+#include <string.h>
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+           1000.;
+}
+
+int edfHierarchyRecognize(const EdfAPI* edf_api, const EdfHierarchyConfig* config, const ERImage* image,
+                          EdfCropParams* crop_params, unsigned int max_level, EdfHierarchyResult* result) {
+    if (!edf_api || !config || !image || !crop_params || !result || config->num_levels == 0 ||
+        config->num_levels > EDF_HIERARCHY_MAX_LEVELS) {
+        return -1;
+    }
+    memset(result, 0, sizeof(EdfHierarchyResult));
+    if (max_level >= config->num_levels) {
+        max_level = config->num_levels - 1;
+    }
+    for (unsigned int level = 0; level <= max_level; level++) {
+        if (level > 0 && config->predicate &&
+            !config->predicate(level - 1, result->result.classify_result, config->predicate_user_data)) {
+            break;
+        }
+        void*              module_state = config->module_states[level];
+        EdfRecognizeResult level_result;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int code = edfRecognize(edf_api, image, crop_params, module_state, &level_result, config->recognize_config);
+        result->level_ms[level] = elapsedMs(start);
+        if (code != 0) {
+            if (level == 0) {
+                return code;
+            }
+            // Keep the result of the shallower level.
+            result->deeper_code = code;
+            break;
+        }
+        if (level > 0) {
+            edfFreeRecognizeResult(edf_api, &result->result, result->module_state);
+        }
+        result->result       = level_result;
+        result->module_state = module_state;
+        result->level        = level;
+    }
+    return 0;
+}
+
+void edfFreeHierarchyResult(const EdfAPI* edf_api, EdfHierarchyResult* result) {
+    if (!edf_api || !result) {
+        return;
+    }
+    edfFreeRecognizeResult(edf_api, &result->result, result->module_state);
+    memset(result, 0, sizeof(EdfHierarchyResult));
+}
+
+int edfHierarchyClassPredicate(unsigned int level, const EdfClassifyResult* result, void* user_data) {
+    (void)level;
+    const EdfHierarchyClassFilter* filter = (const EdfHierarchyClassFilter*)user_data;
+    if (!result || !filter || !filter->task_name || !filter->class_names) {
+        return 0;
+    }
+    // Top class of the task, the values are not sorted for num_top_scores -1.
+    size_t                        task_length = strlen(filter->task_name);
+    const EdfClassifyResultValue* top         = NULL;
+    for (unsigned int i = 0; i < result->num_values; i++) {
+        const EdfClassifyResultValue& value = result->values[i];
+        if (value.task_name_length == task_length && memcmp(value.task_name, filter->task_name, task_length) == 0 &&
+            (!top || value.score > top->score)) {
+            top = &value;
+        }
+    }
+    if (!top || top->score < filter->min_score) {
+        return 0;
+    }
+    for (const char** name = filter->class_names; *name; name++) {
+        if (strlen(*name) == top->class_name_length && memcmp(*name, top->class_name, top->class_name_length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-recognize.h"
+
+// Maximal number of hierarchy levels (VCCT, VCMCT, VCMMCT, VCMMGVCT)
+#define EDF_HIERARCHY_MAX_LEVELS 4
+
+// Decides whether the next (deeper) level is evaluated for the vehicle, returns non-zero to continue.
+// result is the classification result of the given level.
+typedef int (*fcn_edfHierarchyPredicate)(unsigned int level, const EdfClassifyResult* result, void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfHierarchyConfig                                  //
+//////////////////////////////////////////////////////////////
+// EdfHierarchyConfig represents the levels of the model    //
+// hierarchy ordered from the shallowest model, e.g.        //
+// VCCT, VCMMCT, VCMMGVCT module states.                    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int num_levels;                                // number of levels
+    void* module_states[EDF_HIERARCHY_MAX_LEVELS];          // module states of the levels, owned by the caller
+    EdfRecognizeConfig* recognize_config;                   // recognition chain configuration (can be NULL)
+    fcn_edfHierarchyPredicate predicate;                    // early exit predicate (can be NULL to continue always)
+    void* predicate_user_data;                              // user data passed to the predicate
+} EdfHierarchyConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfHierarchyClassFilter                             //
+//////////////////////////////////////////////////////////////
+// EdfHierarchyClassFilter is the user data of the          //
+// edfHierarchyClassPredicate, the deeper level is          //
+// evaluated when the top class of the task is listed.      //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    const char*  task_name;                                 // task of the tested class, e.g. "CATEGORY"
+    const char** class_names;                               // NULL terminated list of the class names to continue
+    float        min_score;                                 // minimal score of the top class to continue
+} EdfHierarchyClassFilter;
+
+//////////////////////////////////////////////////////////////
+//      EdfHierarchyResult                                  //
+//////////////////////////////////////////////////////////////
+// EdfHierarchyResult represents the result of one          //
+// hierarchy call. Free it using edfFreeHierarchyResult.    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfRecognizeResult result;                              // result of the deepest successfully evaluated level
+    void*        module_state;                              // module state of the level of the result
+    unsigned int level;                                     // index of the level of the result
+    int          deeper_code;                               // edfRecognize error code of the failed next level, 0 if
+                                                            // no level failed
+    double       level_ms[EDF_HIERARCHY_MAX_LEVELS];        // recognition chain time of the levels, 0 if not evaluated
+} EdfHierarchyResult;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfHierarchyRecognize                                                                                         //
+//      Runs edfRecognize level by level starting with the shallowest model and stops at max_level or when the      //
+//      predicate of the last evaluated level returns 0. Only the result of the deepest evaluated level is kept,    //
+//      deeper models classify all the tasks of the shallower ones. When a deeper level fails, the evaluation stops //
+//      and the result of the shallower level is returned with the error code in deeper_code.                       //
+//                                                                                                                  //
+//      input:          edf_api     - pointer to the linked Eyedentify API                                          //
+//                      config      - hierarchy configuration                                                       //
+//                      image       - pointer to the input image                                                    //
+//                      crop_params - parameters for the input image alignment (LP or MMRBOX, see edf_type_mmr.h)   //
+//                      max_level   - index of the deepest level to evaluate on request                             //
+//      output:         result      - pointer to the EdfHierarchyResult structure to fill                           //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, edfRecognize error code of the first level otherwise //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfHierarchyRecognize(const EdfAPI* edf_api, const EdfHierarchyConfig* config, const ERImage* image,
+                          EdfCropParams* crop_params, unsigned int max_level, EdfHierarchyResult* result);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeHierarchyResult                                                                                        //
+//      Frees the result created by edfHierarchyRecognize.                                                          //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeHierarchyResult(const EdfAPI* edf_api, EdfHierarchyResult* result);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfHierarchyClassPredicate                                                                                    //
+//      Predicate continuing to the next level when the top class of the filter task is one of the filter classes   //
+//      with at least the minimal score, e.g. make and model only for passenger cars. Use it as                     //
+//      EdfHierarchyConfig.predicate with a pointer to EdfHierarchyClassFilter as the user data.                    //
+//                                                                                                                  //
+//      return value:   1 to continue, 0 to stop                                                                    //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfHierarchyClassPredicate(unsigned int level, const EdfClassifyResult* result, void* user_data);
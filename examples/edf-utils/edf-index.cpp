@@ -0,0 +1,509 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-index.h"
+
+#include "edf-alloc.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#define EDF_INDEX_DEFAULT_MAX_NEIGHBORS   16
+#define EDF_INDEX_DEFAULT_EF_CONSTRUCTION 200
+#define EDF_INDEX_DEFAULT_EF_SEARCH       64
+// Number of descriptor rows allocated at once in the index storage
+#define EDF_INDEX_BLOCK_ROWS              4096
+
+// Candidate of the graph search, the score to the query and the node identifier.
+typedef std::pair<float, unsigned int> IndexCandidate;
+
+struct IndexNode {
+    unsigned int label;                               // user identifier of the descriptor
+    bool         removed;                             // flag if the descriptor was removed from the index
+    std::vector<std::vector<unsigned int> > links;    // neighbours on each layer, links.size() - 1 is the node level
+};
+
+struct EdfIndex {
+    const EdfAPI*  edf_api;
+    const void*    module_state;
+    unsigned int   version;
+    unsigned int   desc_size;                         // set by the first inserted descriptor
+    unsigned int   stride;
+    unsigned int   max_neighbors;
+    unsigned int   ef_construction;
+    unsigned int   ef_search;
+    double         level_mult;
+    std::mt19937   rng;
+    std::vector<IndexNode>      nodes;
+    std::vector<unsigned char*> blocks;               // descriptor storage, EDF_INDEX_BLOCK_ROWS rows per block
+    std::unordered_map<unsigned int, unsigned int> label_nodes;
+    int            entry_node;
+    int            max_level;
+
+    ~EdfIndex() {
+        for (size_t b = 0; b < blocks.size(); b++) {
+            edfFreeAligned(blocks[b]);
+        }
+    }
+
+    const unsigned char* data(unsigned int node) const {
+        return blocks[node / EDF_INDEX_BLOCK_ROWS] + (size_t)(node % EDF_INDEX_BLOCK_ROWS) * stride;
+    }
+
+    int score(const unsigned char* query, unsigned int node, float* value) const {
+        EdfDescriptor desc_a, desc_b;
+        desc_a.version = desc_b.version = version;
+        desc_a.size    = desc_b.size    = desc_size;
+        desc_a.data = (unsigned char*)query;
+        desc_b.data = (unsigned char*)data(node);
+        *value = 0.f;
+        return edf_api->edfCompareDescs(&desc_a, &desc_b, module_state, value);
+    }
+
+    unsigned int maxLinks(int level) const {
+        return level == 0 ? 2 * max_neighbors : max_neighbors;
+    }
+
+    // Greedy walk to the best scoring node on the given layer.
+    int greedyClosest(const unsigned char* query, int level, IndexCandidate* current) const {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            const std::vector<unsigned int>& links = nodes[current->second].links[level];
+            for (size_t i = 0; i < links.size(); i++) {
+                float value = 0.f;
+                int   code  = score(query, links[i], &value);
+                if (code != 0) {
+                    return code;
+                }
+                if (value > current->first) {
+                    *current = IndexCandidate(value, links[i]);
+                    changed  = true;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Beam search of the given layer, outputs up to ef candidates sorted by descending score. With live_only the
+    // removed nodes are still expanded but do not take a place among the ef found candidates, the search goes on
+    // until ef live nodes are found or the reachable part of the layer is exhausted.
+    int searchLayer(const unsigned char* query, IndexCandidate entry, unsigned int ef, int level, bool live_only,
+                    std::vector<IndexCandidate>* result) const {
+        std::unordered_set<unsigned int> visited;
+        visited.insert(entry.second);
+        // candidates: best on top, found: worst on top
+        std::priority_queue<IndexCandidate> candidates;
+        std::priority_queue<IndexCandidate, std::vector<IndexCandidate>, std::greater<IndexCandidate> > found;
+        candidates.push(entry);
+        if (!live_only || !nodes[entry.second].removed) {
+            found.push(entry);
+        }
+        while (!candidates.empty()) {
+            IndexCandidate current = candidates.top();
+            if (found.size() >= ef && current.first < found.top().first) {
+                break;
+            }
+            candidates.pop();
+            const std::vector<unsigned int>& links = nodes[current.second].links[level];
+            for (size_t i = 0; i < links.size(); i++) {
+                if (!visited.insert(links[i]).second) {
+                    continue;
+                }
+                float value = 0.f;
+                int   code  = score(query, links[i], &value);
+                if (code != 0) {
+                    return code;
+                }
+                if (found.size() < ef || value > found.top().first) {
+                    candidates.push(IndexCandidate(value, links[i]));
+                    if (!live_only || !nodes[links[i]].removed) {
+                        found.push(IndexCandidate(value, links[i]));
+                        if (found.size() > ef) {
+                            found.pop();
+                        }
+                    }
+                }
+            }
+        }
+        result->clear();
+        result->reserve(found.size());
+        while (!found.empty()) {
+            result->push_back(found.top());
+            found.pop();
+        }
+        std::reverse(result->begin(), result->end());
+        return 0;
+    }
+
+    // HNSW neighbour selection heuristic: skip candidates closer to an already selected neighbour than to the
+    // base node, fill the rest with the skipped ones. Keeps the graph connected across clusters.
+    int selectNeighbors(const std::vector<IndexCandidate>& sorted, unsigned int count,
+                        std::vector<unsigned int>* selected) const {
+        std::vector<unsigned int> skipped;
+        selected->clear();
+        for (size_t i = 0; i < sorted.size() && selected->size() < count; i++) {
+            bool keep = true;
+            for (size_t j = 0; j < selected->size() && keep; j++) {
+                float value = 0.f;
+                int   code  = score(data(sorted[i].second), (*selected)[j], &value);
+                if (code != 0) {
+                    return code;
+                }
+                keep = value <= sorted[i].first;
+            }
+            if (keep) {
+                selected->push_back(sorted[i].second);
+            } else {
+                skipped.push_back(sorted[i].second);
+            }
+        }
+        for (size_t i = 0; i < skipped.size() && selected->size() < count; i++) {
+            selected->push_back(skipped[i]);
+        }
+        return 0;
+    }
+
+    // Outputs up to ef live nodes with the highest score to the query, sorted by descending score.
+    int search(const unsigned char* query, unsigned int ef, std::vector<IndexCandidate>* result) const {
+        result->clear();
+        if (entry_node < 0) {
+            return 0;
+        }
+        IndexCandidate current(0.f, (unsigned int)entry_node);
+        int code = score(query, entry_node, &current.first);
+        for (int level = max_level; level > 0 && code == 0; level--) {
+            code = greedyClosest(query, level, &current);
+        }
+        if (code != 0) {
+            return code;
+        }
+        return searchLayer(query, current, ef, 0, true, result);
+    }
+
+    // Adds the descriptor to the graph and maps the label to it.
+    // On failure the new node stays in the graph as a removed node and the label keeps its previous node.
+    int insert(const EdfDescriptor* desc, unsigned int label) {
+        unsigned int node = (unsigned int)nodes.size();
+        if (node % EDF_INDEX_BLOCK_ROWS == 0) {
+            unsigned char* block = (unsigned char*)edfAllocAligned((size_t)EDF_INDEX_BLOCK_ROWS * stride);
+            if (!block) {
+                return -1;
+            }
+            blocks.push_back(block);
+        }
+        memcpy((unsigned char*)data(node), desc->data, desc_size);
+
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        int level = (int)(-std::log(std::max(uniform(rng), DBL_MIN)) * level_mult);
+
+        IndexNode index_node;
+        index_node.label   = label;
+        index_node.removed = true;
+        index_node.links.resize(level + 1);
+        nodes.push_back(index_node);
+
+        if (entry_node < 0) {
+            entry_node = (int)node;
+            max_level  = level;
+            publish(node, label);
+            return 0;
+        }
+        const unsigned char* query = data(node);
+        IndexCandidate current(0.f, (unsigned int)entry_node);
+        int code = score(query, entry_node, &current.first);
+        for (int l = max_level; l > level && code == 0; l--) {
+            code = greedyClosest(query, l, &current);
+        }
+        for (int l = std::min(level, max_level); l >= 0 && code == 0; l--) {
+            std::vector<IndexCandidate> found;
+            std::vector<unsigned int>   neighbors;
+            code = searchLayer(query, current, ef_construction, l, false, &found);
+            if (code == 0) {
+                code = selectNeighbors(found, max_neighbors, &neighbors);
+            }
+            if (code != 0) {
+                break;
+            }
+            nodes[node].links[l] = neighbors;
+            for (size_t i = 0; i < neighbors.size() && code == 0; i++) {
+                std::vector<unsigned int>& links = nodes[neighbors[i]].links[l];
+                links.push_back(node);
+                if (links.size() > maxLinks(l)) {
+                    // Shrink the neighbour list of the linked node.
+                    const unsigned char* base = data(neighbors[i]);
+                    std::vector<IndexCandidate> linked;
+                    std::vector<unsigned int>   shrunk;
+                    linked.reserve(links.size());
+                    for (size_t j = 0; j < links.size() && code == 0; j++) {
+                        float value = 0.f;
+                        code = score(base, links[j], &value);
+                        linked.push_back(IndexCandidate(value, links[j]));
+                    }
+                    if (code == 0) {
+                        std::sort(linked.begin(), linked.end(), std::greater<IndexCandidate>());
+                        code = selectNeighbors(linked, maxLinks(l), &shrunk);
+                    }
+                    if (code == 0) {
+                        links = shrunk;
+                    }
+                }
+            }
+            current = found.front();
+        }
+        if (code != 0) {
+            return code;
+        }
+        if (level > max_level) {
+            entry_node = (int)node;
+            max_level  = level;
+        }
+        publish(node, label);
+        return 0;
+    }
+
+    // Maps the label to the node, the previous node of the label is marked as removed.
+    void publish(unsigned int node, unsigned int label) {
+        std::pair<std::unordered_map<unsigned int, unsigned int>::iterator, bool> mapped =
+            label_nodes.insert(std::make_pair(label, node));
+        if (!mapped.second) {
+            nodes[mapped.first->second].removed = true;
+            mapped.first->second = node;
+        }
+        nodes[node].removed = false;
+    }
+
+    // Exchanges the graph and the descriptor storage with the other index, the configuration is kept.
+    void swapGraph(EdfIndex& other) {
+        nodes.swap(other.nodes);
+        blocks.swap(other.blocks);
+        label_nodes.swap(other.label_nodes);
+        std::swap(rng, other.rng);
+        std::swap(entry_node, other.entry_node);
+        std::swap(max_level, other.max_level);
+    }
+};
+
+static int checkDesc(const EdfIndex* index, const EdfDescriptor* desc) {
+    if (!desc || !desc->data) {
+        return -1;
+    }
+    if (desc->version != index->version || (index->desc_size != 0 && desc->size != index->desc_size)) {
+        return -2;
+    }
+    return 0;
+}
+
+int edfIndexCreate(const EdfAPI* edf_api, const void* module_state, const EdfIndexConfig* config, void** index) {
+    if (!edf_api || !edf_api->edfCompareDescs || !edf_api->edfModelVersion || !module_state || !index) {
+        return -1;
+    }
+    unsigned int version = edf_api->edfModelVersion(module_state);
+    if (version == 0) {
+        return -2;
+    }
+    EdfIndex* state = new EdfIndex();
+    state->edf_api         = edf_api;
+    state->module_state    = module_state;
+    state->version         = version;
+    state->desc_size       = 0;
+    state->stride          = 0;
+    state->max_neighbors   = (config && config->max_neighbors   > 1) ? config->max_neighbors   : EDF_INDEX_DEFAULT_MAX_NEIGHBORS;
+    state->ef_construction = (config && config->ef_construction > 0) ? config->ef_construction : EDF_INDEX_DEFAULT_EF_CONSTRUCTION;
+    state->ef_search       = (config && config->ef_search       > 0) ? config->ef_search       : EDF_INDEX_DEFAULT_EF_SEARCH;
+    state->level_mult      = 1.0 / std::log((double)state->max_neighbors);
+    state->rng.seed(config ? config->seed : 0);
+    state->entry_node      = -1;
+    state->max_level       = -1;
+    *index = state;
+    return 0;
+}
+
+void edfIndexFree(void** index) {
+    if (index && *index) {
+        delete (EdfIndex*)*index;
+        *index = NULL;
+    }
+}
+
+int edfIndexInsert(void* index, const EdfDescriptor* desc, unsigned int label) {
+    EdfIndex* state = (EdfIndex*)index;
+    if (!state) {
+        return -1;
+    }
+    int check_code = checkDesc(state, desc);
+    if (check_code != 0) {
+        return check_code;
+    }
+    if (state->desc_size == 0) {
+        state->desc_size = desc->size;
+        state->stride    = edfGalleryStride(desc->size);
+    }
+    // Replacing a label hides its previous descriptor.
+    return state->insert(desc, label);
+}
+
+int edfIndexRemove(void* index, unsigned int label) {
+    EdfIndex* state = (EdfIndex*)index;
+    if (!state) {
+        return -1;
+    }
+    std::unordered_map<unsigned int, unsigned int>::iterator it = state->label_nodes.find(label);
+    if (it == state->label_nodes.end()) {
+        return -3;
+    }
+    state->nodes[it->second].removed = true;
+    state->label_nodes.erase(it);
+    return 0;
+}
+
+unsigned int edfIndexSize(const void* index) {
+    return index ? (unsigned int)((const EdfIndex*)index)->label_nodes.size() : 0;
+}
+
+int edfIndexSearch(const void* index, const EdfDescriptor* query, unsigned int top_k, unsigned int ef_search,
+                   EdfSearchResult* results, unsigned int* num_results) {
+    const EdfIndex* state = (const EdfIndex*)index;
+    if (!state || !num_results || (top_k > 0 && !results)) {
+        return -1;
+    }
+    int check_code = checkDesc(state, query);
+    if (check_code != 0) {
+        return check_code;
+    }
+    *num_results = 0;
+    if (top_k == 0) {
+        return 0;
+    }
+    unsigned int ef = std::max(ef_search > 0 ? ef_search : state->ef_search, top_k);
+    std::vector<IndexCandidate> found;
+    int code = state->search(query->data, ef, &found);
+    if (code != 0) {
+        return code;
+    }
+    unsigned int count = std::min((unsigned int)found.size(), top_k);
+    for (unsigned int i = 0; i < count; i++) {
+        results[i].index = state->nodes[found[i].second].label;
+        results[i].score = found[i].first;
+    }
+    *num_results = count;
+    return 0;
+}
+
+int edfIndexCompact(void* index) {
+    EdfIndex* state = (EdfIndex*)index;
+    if (!state) {
+        return -1;
+    }
+    if (state->label_nodes.size() == state->nodes.size()) {
+        return 0;
+    }
+    // Rebuild the graph from the present descriptors in the insertion order.
+    EdfIndex* compact = new EdfIndex();
+    compact->edf_api         = state->edf_api;
+    compact->module_state    = state->module_state;
+    compact->version         = state->version;
+    compact->desc_size       = state->desc_size;
+    compact->stride          = state->stride;
+    compact->max_neighbors   = state->max_neighbors;
+    compact->ef_construction = state->ef_construction;
+    compact->ef_search       = state->ef_search;
+    compact->level_mult      = state->level_mult;
+    compact->rng             = state->rng;
+    compact->entry_node      = -1;
+    compact->max_level       = -1;
+    for (size_t n = 0; n < state->nodes.size(); n++) {
+        if (state->nodes[n].removed) {
+            continue;
+        }
+        EdfDescriptor desc;
+        desc.version = state->version;
+        desc.size    = state->desc_size;
+        desc.data    = (unsigned char*)state->data((unsigned int)n);
+        int code = compact->insert(&desc, state->nodes[n].label);
+        if (code != 0) {
+            delete compact;
+            return code;
+        }
+    }
+    state->swapGraph(*compact);
+    delete compact;
+    return 0;
+}
+
+int edfIndexMeasureRecall(const void* index, const EdfDescriptor* queries, unsigned int num_queries,
+                          unsigned int top_k, unsigned int ef_search, float* recall) {
+    const EdfIndex* state = (const EdfIndex*)index;
+    if (!state || !recall || (num_queries > 0 && !queries) || top_k == 0) {
+        return -1;
+    }
+    *recall = 0.f;
+    std::vector<EdfSearchResult> approx(top_k);
+    double recall_sum = 0.0;
+    for (unsigned int q = 0; q < num_queries; q++) {
+        unsigned int num_approx = 0;
+        int code = edfIndexSearch(index, &queries[q], top_k, ef_search, &approx[0], &num_approx);
+        if (code != 0) {
+            return code;
+        }
+        // Exact top_k by brute force over all present descriptors.
+        std::vector<IndexCandidate> exact;
+        exact.reserve(state->label_nodes.size());
+        for (size_t n = 0; n < state->nodes.size(); n++) {
+            if (state->nodes[n].removed) {
+                continue;
+            }
+            float value = 0.f;
+            code = state->score(queries[q].data, (unsigned int)n, &value);
+            if (code != 0) {
+                return code;
+            }
+            exact.push_back(IndexCandidate(value, state->nodes[n].label));
+        }
+        size_t k = std::min((size_t)top_k, exact.size());
+        if (k == 0) {
+            recall_sum += 1.0;
+            continue;
+        }
+        std::partial_sort(exact.begin(), exact.begin() + k, exact.end(), std::greater<IndexCandidate>());
+        unsigned int hits = 0;
+        for (size_t i = 0; i < k; i++) {
+            for (unsigned int j = 0; j < num_approx; j++) {
+                if (approx[j].index == exact[i].second) {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        recall_sum += (double)hits / k;
+    }
+    *recall = num_queries > 0 ? (float)(recall_sum / num_queries) : 1.f;
+    return 0;
+}
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-search.h"
+
+//////////////////////////////////////////////////////////////
+//      EdfIndexConfig                                      //
+//////////////////////////////////////////////////////////////
+// EdfIndexConfig represents the configuration parameters   //
+// of the approximate nearest neighbour index (HNSW graph). //
+// Set a value to 0 to use its default.                     //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int max_neighbors;    // Number of graph neighbours of one descriptor (HNSW M), 2x on the bottom layer. DEFAULT 16
+                                   // Higher values increase recall, memory and insertion time.
+    unsigned int ef_construction;  // Size of the candidate list used during insertion. DEFAULT 200
+                                   // Higher values build a better graph at the cost of slower insertion.
+    unsigned int ef_search;        // Size of the candidate list used during search, the recall vs. latency knob. DEFAULT 64
+                                   // Can be overridden per query in edfIndexSearch.
+    unsigned int seed;             // Seed of the random level generator. DEFAULT 0
+} EdfIndexConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexCreate                                                                                                //
+//      Creates an empty approximate nearest neighbour index of descriptors computed by the given module state.     //
+//      The index is keyed by edfModelVersion of the module state, descriptors of other versions are rejected.      //
+//      The similarity of descriptors is the edfCompareDescs score, the module state must outlive the index.        //
+//      The index is not thread-safe, serialize all calls including edfIndexSearch, it calls edfCompareDescs on     //
+//      the module state that does not support concurrent calls.                                                    //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state                                                  //
+//                      config       - index configuration (can be NULL)                                            //
+//      output:         index        - pointer to the index                                                         //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 model version is not available                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexCreate(const EdfAPI* edf_api, const void* module_state, const EdfIndexConfig* config, void** index);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexFree                                                                                                  //
+//      Frees the index previously created by edfIndexCreate.                                                       //
+//                                                                                                                  //
+//      input:          index - pointer to the index                                                                //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfIndexFree(void** index);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexInsert                                                                                                //
+//      Inserts the descriptor to the index. The descriptor data are copied to the index storage. Inserting         //
+//      an already present label replaces its descriptor.                                                           //
+//                                                                                                                  //
+//      input:          index - pointer to the index                                                                //
+//                      desc  - descriptor outputted by edfComputeDesc                                              //
+//                      label - user identifier of the descriptor, returned as EdfSearchResult.index                //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, edfCompareDescs error code otherwise     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexInsert(void* index, const EdfDescriptor* desc, unsigned int label);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexRemove                                                                                                //
+//      Removes the descriptor with the given label from the index. The descriptor is only marked as removed,       //
+//      it stays in the graph to keep it connected, but it is never returned by edfIndexSearch. Call                //
+//      edfIndexCompact to reclaim the removed and replaced descriptors.                                            //
+//                                                                                                                  //
+//      input:          index - pointer to the index                                                                //
+//                      label - user identifier of the descriptor                                                   //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -3 label not found                                                    //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexRemove(void* index, unsigned int label);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexSize                                                                                                  //
+//      Returns the number of descriptors in the index, removed descriptors are not counted.                        //
+//                                                                                                                  //
+//      input:          index - pointer to the index                                                                //
+//                                                                                                                  //
+//      return value:   number of descriptors                                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int edfIndexSize(const void* index);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexSearch                                                                                                //
+//      Searches the index for the top_k descriptors with the highest score to the query descriptor. Removed        //
+//      descriptors are traversed but not counted to the ef_search candidates, the search goes on until ef_search   //
+//      present descriptors are found, so the removed descriptors do not reduce the number of results.              //
+//                                                                                                                  //
+//      input:          index       - pointer to the index                                                          //
+//                      query       - query descriptor, outputted by edfComputeDesc                                 //
+//                      top_k       - maximal number of results to return                                           //
+//                      ef_search   - size of the candidate list, higher values increase recall and latency         //
+//                                    Set 0 to use EdfIndexConfig.ef_search.                                        //
+//      output:         results     - user allocated array of top_k results sorted by descending score,             //
+//                                    EdfSearchResult.index contains the label of the descriptor                    //
+//                      num_results - number of filled results                                                      //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, edfCompareDescs error code otherwise     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexSearch(const void* index, const EdfDescriptor* query, unsigned int top_k, unsigned int ef_search,
+                   EdfSearchResult* results, unsigned int* num_results);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexCompact                                                                                               //
+//      Rebuilds the graph from the present descriptors and frees the removed and replaced ones. Every removed      //
+//      descriptor still costs memory and search time, call it when a large part of the index was removed or        //
+//      replaced. The rebuild inserts all present descriptors again, it takes as long as building a new index.      //
+//      On failure the index is left unchanged.                                                                     //
+//                                                                                                                  //
+//      input:          index - pointer to the index                                                                //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, edfCompareDescs error code otherwise                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexCompact(void* index);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfIndexMeasureRecall                                                                                         //
+//      Measures the recall of edfIndexSearch against the exact brute-force search using edfCompareDescs over all   //
+//      descriptors of the index. Use a local set of queries to tune ef_search for the required recall.             //
+//                                                                                                                  //
+//      input:          index       - pointer to the index                                                          //
+//                      queries     - array of query descriptors                                                    //
+//                      num_queries - number of query descriptors                                                   //
+//                      top_k       - number of results compared for each query                                     //
+//                      ef_search   - size of the candidate list passed to edfIndexSearch                           //
+//      output:         recall      - mean fraction of the exact top_k results found by edfIndexSearch, <0,1>       //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, edfCompareDescs error code otherwise     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfIndexMeasureRecall(const void* index, const EdfDescriptor* queries, unsigned int num_queries,
+                          unsigned int top_k, unsigned int ef_search, float* recall);
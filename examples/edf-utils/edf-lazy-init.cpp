@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-lazy-init.h"
+#include "edf-model-cache.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct EdfLazyState {
+    const EdfAPI*           edf_api;
+    // Copy of the init configuration, the strings are owned by the lazy state.
+    std::string             module_path;
+    std::string             model_file;
+    std::string             onnx_provider;
+    bool                    has_onnx_provider;
+    EdfInitConfig           init_config;
+    EdfLazyInitConfig       config;
+    std::chrono::steady_clock::time_point start;
+
+    std::mutex              mutex;
+    std::condition_variable cond;
+    bool                    ready;
+    int                     code;
+    void*                   module_state;
+    EdfInitStats            stats;
+    std::thread             worker;
+};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+           1000.;
+}
+
+static bool modelFileValid(const char* module_path, const char* model_file) {
+    std::string path(module_path ? module_path : "");
+    if (!path.empty() && path[path.length() - 1] != '/' && path[path.length() - 1] != '\\') {
+        path += "/";
+    }
+    path += model_file;
+    FILE* file_id;
+    EDF_FILE_OPEN(file_id, path.c_str());
+    if (!file_id) {
+        return false;
+    }
+    bool valid = fseek(file_id, 0, SEEK_END) == 0 && ftell(file_id) > 0;
+    fclose(file_id);
+    return valid;
+}
+
+static void initWorker(EdfLazyState* state) {
+    std::chrono::steady_clock::time_point phase = std::chrono::steady_clock::now();
+    // The read errors are reported by edfInitEyedentify.
+    edfModelPrefetch(state->init_config.module_path, state->init_config.model_file);
+    double file_read_ms = elapsedMs(phase);
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stats.file_read_ms = file_read_ms;
+    }
+
+    phase = std::chrono::steady_clock::now();
+    void* module_state = NULL;
+    int code = state->edf_api->edfInitEyedentify(&state->init_config, &module_state);
+    double init_ms = elapsedMs(phase);
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stats.init_ms = init_ms;
+    }
+
+    double warmup_ms = 0.0;
+    if (code == 0 && state->config.warmup) {
+        phase = std::chrono::steady_clock::now();
+        code = state->config.warmup(state->edf_api, module_state, state->config.warmup_user_data);
+        warmup_ms = elapsedMs(phase);
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->stats.warmup_ms = warmup_ms;
+    state->stats.total_ms  = elapsedMs(state->start);
+    state->module_state    = module_state;
+    state->code            = code;
+    state->ready           = true;
+    state->cond.notify_all();
+}
+
+int edfInitEyedentifyLazy(const EdfAPI* edf_api, const EdfInitConfig* init_config, const EdfLazyInitConfig* config,
+                          void** lazy_state) {
+    if (!edf_api || !edf_api->edfInitEyedentify || !init_config || !init_config->model_file || !lazy_state) {
+        return -1;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!modelFileValid(init_config->module_path, init_config->model_file)) {
+        return -2;
+    }
+    EdfLazyState* state = new EdfLazyState();
+    state->edf_api           = edf_api;
+    state->module_path       = init_config->module_path ? init_config->module_path : "";
+    state->model_file        = init_config->model_file;
+    state->has_onnx_provider = init_config->onnx_provider != NULL;
+    state->onnx_provider     = state->has_onnx_provider ? init_config->onnx_provider : "";
+    state->init_config               = *init_config;
+    state->init_config.module_path   = init_config->module_path ? state->module_path.c_str() : NULL;
+    state->init_config.model_file    = state->model_file.c_str();
+    state->init_config.onnx_provider = state->has_onnx_provider ? state->onnx_provider.c_str() : NULL;
+    state->config.warmup           = config ? config->warmup : NULL;
+    state->config.warmup_user_data = config ? config->warmup_user_data : NULL;
+    state->start        = start;
+    state->ready        = false;
+    state->code         = 0;
+    state->module_state = NULL;
+    state->stats.validate_ms  = elapsedMs(start);
+    state->stats.file_read_ms = 0.0;
+    state->stats.init_ms      = 0.0;
+    state->stats.warmup_ms    = 0.0;
+    state->stats.total_ms     = 0.0;
+    state->worker = std::thread(initWorker, state);
+    *lazy_state = state;
+    return 0;
+}
+
+int edfLazyIsReady(const void* lazy_state) {
+    if (!lazy_state) {
+        return 0;
+    }
+    EdfLazyState* state = (EdfLazyState*)lazy_state;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->ready ? 1 : 0;
+}
+
+int edfLazyGetModuleState(void* lazy_state, void** module_state) {
+    if (!lazy_state || !module_state) {
+        return -1;
+    }
+    EdfLazyState* state = (EdfLazyState*)lazy_state;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [state]() { return state->ready; });
+    *module_state = state->module_state;
+    return state->code;
+}
+
+int edfLazyGetInitStats(const void* lazy_state, EdfInitStats* stats) {
+    if (!lazy_state || !stats) {
+        return -1;
+    }
+    EdfLazyState* state = (EdfLazyState*)lazy_state;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    *stats = state->stats;
+    return 0;
+}
+
+void edfFreeLazyState(void** lazy_state) {
+    if (!lazy_state || !*lazy_state) {
+        return;
+    }
+    EdfLazyState* state = (EdfLazyState*)*lazy_state;
+    state->worker.join();
+    if (state->module_state) {
+        state->edf_api->edfFreeEyedentify(&state->module_state);
+    }
+    delete state;
+    *lazy_state = NULL;
+}
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+// Warm-up function run on the background thread right after the module initialization, e.g. one edfCropImage and
+// edfComputeDesc call on a representative image. Returns 0 on success.
+typedef int (*fcn_edfWarmup)(const EdfAPI* edf_api, void* module_state, void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfLazyInitConfig                                   //
+//////////////////////////////////////////////////////////////
+// EdfLazyInitConfig represents the configuration           //
+// parameters of the background module initialization.      //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    fcn_edfWarmup warmup;                // warm-up function, NULL for no warm-up
+    void*         warmup_user_data;      // user data passed to the warm-up function
+} EdfLazyInitConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfInitStats                                        //
+//////////////////////////////////////////////////////////////
+// EdfInitStats splits the module initialization time into  //
+// its phases. The times of unfinished phases are 0.        //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    double validate_ms;                  // model file check done by edfInitEyedentifyLazy
+    double file_read_ms;                 // reading the model file to the page cache
+    double init_ms;                      // edfInitEyedentify with the model file already in memory
+    double warmup_ms;                    // warm-up function
+    double total_ms;                     // from edfInitEyedentifyLazy to the module being ready
+} EdfInitStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfInitEyedentifyLazy                                                                                         //
+//      Checks that the model file exists and is readable and returns immediately. The model file is read, the      //
+//      module is initialized by edfInitEyedentify and warmed up on a background thread. The module state is        //
+//      obtained by edfLazyGetModuleState, which waits for the initialization to finish.                            //
+//      The init configuration strings are copied, the structure does not need to outlive the call.                 //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      init_config  - pointer to the initialization structure                                      //
+//                      config       - background initialization configuration (can be NULL)                        //
+//      output:         lazy_state   - pointer to the lazy initialization state                                     //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the model file is missing or empty             //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfInitEyedentifyLazy(const EdfAPI* edf_api, const EdfInitConfig* init_config, const EdfLazyInitConfig* config,
+                          void** lazy_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfLazyIsReady                                                                                                //
+//      Returns immediately whether the background initialization has finished, e.g. for a readiness probe.         //
+//                                                                                                                  //
+//      input:          lazy_state - pointer to the lazy initialization state                                       //
+//                                                                                                                  //
+//      return value:   1 if finished (successfully or not), 0 otherwise                                            //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfLazyIsReady(const void* lazy_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfLazyGetModuleState                                                                                         //
+//      Waits for the background initialization to finish and returns the module state. Call it before the first    //
+//      SDK call. The module state is owned by the lazy state.                                                      //
+//                                                                                                                  //
+//      input:          lazy_state   - pointer to the lazy initialization state                                     //
+//      output:         module_state - pointer to the module state                                                  //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments,                                                      //
+//                      edfInitEyedentify or warm-up function error code otherwise                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfLazyGetModuleState(void* lazy_state, void** module_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfLazyGetInitStats                                                                                           //
+//      Returns the initialization times measured so far, without waiting.                                          //
+//                                                                                                                  //
+//      input:          lazy_state - pointer to the lazy initialization state                                       //
+//      output:         stats      - pointer to the EdfInitStats structure to fill                                  //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfLazyGetInitStats(const void* lazy_state, EdfInitStats* stats);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeLazyState                                                                                              //
+//      Waits for the background initialization to finish and frees the module state and the lazy state.            //
+//                                                                                                                  //
+//      input:          lazy_state - pointer to the lazy initialization state                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeLazyState(void** lazy_state);
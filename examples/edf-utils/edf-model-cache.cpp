@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-model-cache.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !(_WIN32 || _WIN64)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Size of the buffer used to read the model file by edfModelPrefetch
+#define EDF_MODEL_PREFETCH_CHUNK (1 << 20)
+
+struct CachedModel {
+    std::string  key;
+    void*        module_state;
+    void*        shared_state;                        // the only handle given to the holders
+    unsigned int num_holders;                         // callers waiting for the loading included
+    bool         loading;                             // edfInitEyedentify is running outside of g_cache_mutex
+    int          init_code;                           // result of the loading
+};
+
+// Cached models by their configuration key and by their shared state.
+static std::mutex                            g_cache_mutex;
+static std::condition_variable               g_cache_loaded;
+static std::map<std::string, CachedModel*>   g_cache_by_key;
+static std::map<void*, CachedModel*>         g_cache_by_state;
+
+static std::string modelFilePath(const char* module_path, const char* model_file) {
+    std::string path(module_path ? module_path : "");
+    if (!path.empty() && path[path.length() - 1] != '/' && path[path.length() - 1] != '\\') {
+        path += "/";
+    }
+    return path + model_file;
+}
+
+static std::string cacheKey(const EdfInitConfig* init_config, const EdfSharedStateConfig* shared_config) {
+    std::ostringstream key;
+    key << (init_config->module_path ? init_config->module_path : "") << '\n'
+        << (init_config->model_file ? init_config->model_file : "") << '\n'
+        << (int)init_config->computation_mode << '\n'
+        << init_config->gpu_device_id << '\n'
+        << init_config->num_threads << '\n'
+        << (init_config->onnx_provider ? init_config->onnx_provider : "") << '\n'
+        << (shared_config && shared_config->concurrent_const_calls == EDF_CONFIG_VALUE_ENABLED);
+    return key.str();
+}
+
+int edfModelCacheAcquire(const EdfAPI* edf_api, const EdfInitConfig* init_config,
+                         const EdfSharedStateConfig* shared_config, void** shared_state) {
+    if (!edf_api || !edf_api->edfInitEyedentify || !edf_api->edfFreeEyedentify || !init_config ||
+        !init_config->model_file || !shared_state) {
+        return -1;
+    }
+    std::string key = cacheKey(init_config, shared_config);
+    std::unique_lock<std::mutex> lock(g_cache_mutex);
+    std::map<std::string, CachedModel*>::iterator it = g_cache_by_key.find(key);
+    if (it != g_cache_by_key.end()) {
+        CachedModel* model = it->second;
+        model->num_holders++;
+        while (model->loading) {
+            g_cache_loaded.wait(lock);
+        }
+        if (model->init_code != 0) {
+            int code = model->init_code;
+            if (--model->num_holders == 0) {
+                delete model;
+            }
+            return code;
+        }
+        *shared_state = model->shared_state;
+        return 0;
+    }
+    CachedModel* model = new CachedModel();
+    model->key          = key;
+    model->module_state = NULL;
+    model->shared_state = NULL;
+    model->num_holders  = 1;
+    model->loading      = true;
+    model->init_code    = 0;
+    g_cache_by_key[key] = model;
+    lock.unlock();
+
+    // Load the model without the cache lock, other configurations can be acquired and released meanwhile.
+    void* module_state = NULL;
+    void* shared       = NULL;
+    int code = edf_api->edfInitEyedentify(init_config, &module_state);
+    if (code == 0) {
+        code = edfCreateSharedState(edf_api, module_state, shared_config, &shared);
+        if (code != 0) {
+            edf_api->edfFreeEyedentify(&module_state);
+        }
+    }
+
+    lock.lock();
+    model->loading   = false;
+    model->init_code = code;
+    if (code == 0) {
+        model->module_state      = module_state;
+        model->shared_state      = shared;
+        g_cache_by_state[shared] = model;
+        *shared_state            = shared;
+    } else {
+        // The waiting callers fail with the same code, the next call loads the model again.
+        g_cache_by_key.erase(key);
+        if (--model->num_holders == 0) {
+            delete model;
+        }
+    }
+    g_cache_loaded.notify_all();
+    return code;
+}
+
+int edfModelCacheRelease(const EdfAPI* edf_api, void** shared_state) {
+    if (!edf_api || !shared_state || !*shared_state) {
+        return -1;
+    }
+    std::unique_lock<std::mutex> lock(g_cache_mutex);
+    std::map<void*, CachedModel*>::iterator it = g_cache_by_state.find(*shared_state);
+    if (it == g_cache_by_state.end()) {
+        return -1;
+    }
+    CachedModel* model = it->second;
+    *shared_state = NULL;
+    if (--model->num_holders > 0) {
+        return 0;
+    }
+    g_cache_by_state.erase(it);
+    g_cache_by_key.erase(model->key);
+    lock.unlock();
+
+    edfFreeSharedState(&model->shared_state);
+    edf_api->edfFreeEyedentify(&model->module_state);
+    delete model;
+    return 0;
+}
+
+int edfModelPrefetch(const char* module_path, const char* model_file) {
+    if (!model_file) {
+        return -1;
+    }
+    std::string path = modelFilePath(module_path, model_file);
+#if !(_WIN32 || _WIN64) && defined(POSIX_FADV_WILLNEED)
+    // Let the kernel start the readahead of the whole file before the sequential read below.
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+#endif
+    FILE* file_id;
+    EDF_FILE_OPEN(file_id, path.c_str());
+    if (!file_id) {
+        return -2;
+    }
+    std::vector<char> buffer(EDF_MODEL_PREFETCH_CHUNK);
+    while (fread(&buffer[0], 1, buffer.size(), file_id) == buffer.size()) {
+    }
+    bool failed = ferror(file_id) != 0;
+    fclose(file_id);
+    return failed ? -2 : 0;
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-context.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfModelCacheAcquire                                                                                          //
+//      Returns the shared state (edf-context.h) of the module initialized with the given configuration. The first  //
+//      call initializes the module using edfInitEyedentify and wraps it by edfCreateSharedState, next calls with   //
+//      the same configuration (module path, model file, computation mode, GPU device, number of threads, ONNX      //
+//      provider and concurrent_const_calls) return the same shared state without loading the model again. The      //
+//      holders call the module through their own contexts (edfCreateContext), the module state is never given      //
+//      out. Each acquired shared state must be released by edfModelCacheRelease. The function is thread-safe, the  //
+//      model is loaded without holding the cache lock, the callers acquiring the same configuration meanwhile      //
+//      wait for the loading and get its result.                                                                    //
+//                                                                                                                  //
+//      input:          edf_api       - pointer to the linked Eyedentify API                                        //
+//                      init_config   - pointer to the initialization structure                                     //
+//                      shared_config - shared state configuration (can be NULL)                                    //
+//      output:         shared_state  - pointer to the shared state                                                 //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, edfInitEyedentify error code otherwise                                //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfModelCacheAcquire(const EdfAPI* edf_api, const EdfInitConfig* init_config,
+                         const EdfSharedStateConfig* shared_config, void** shared_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfModelCacheRelease                                                                                          //
+//      Releases the shared state acquired by edfModelCacheAcquire, the contexts created over it by the holder must //
+//      be freed before. The shared state and the module state are freed using edfFreeSharedState and               //
+//      edfFreeEyedentify when the last holder releases it. The pointer is set to NULL.                             //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      shared_state - pointer to the shared state                                                  //
+//                                                                                                                  //
+//      return value:   0 on success, -1 if the shared state was not acquired from the cache                        //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfModelCacheRelease(const EdfAPI* edf_api, void** shared_state);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfModelPrefetch                                                                                              //
+//      Reads the model file to the operating system page cache. The cached pages are shared by all processes on    //
+//      the host, so the file reading part of edfInitEyedentify of every process is served from memory.             //
+//      Call it at the service startup, e.g. for all models used by the processes on the host.                      //
+//                                                                                                                  //
+//      input:          module_path - path to the module (EdfInitConfig.module_path)                                //
+//                      model_file  - model filename (EdfInitConfig.model_file)                                     //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the model file could not be read               //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfModelPrefetch(const char* module_path, const char* model_file);
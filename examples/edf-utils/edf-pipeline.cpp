@@ -0,0 +1,374 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-pipeline.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+struct EdfPipeline;
+
+struct PipelineItem {
+    EdfPipelineItem                       item;
+    unsigned int                          state_index;  // module state of the crop, descriptor and classification
+    ERImage                               crop;
+    bool                                  has_crop;
+    bool                                  released;
+    std::chrono::steady_clock::time_point pushed;
+};
+
+struct PipelineQueue {
+    std::deque<PipelineItem*> items;
+    unsigned int              capacity;
+    int                       overflow;
+    bool                      closed;
+    std::condition_variable   not_empty;
+    std::condition_variable   not_full;
+    EdfPipelineStageStats     stats;
+};
+
+struct PipelineStream {
+    unsigned long long                          next_push; // sequence of the next pushed frame
+    unsigned long long                          next_sink; // sequence of the next frame passed to the sink
+    bool                                        sinking;   // a thread is passing frames of the stream to the sink
+    std::map<unsigned long long, PipelineItem*> pending;   // finished frames waiting for their predecessors
+};
+
+struct EdfPipeline {
+    const EdfAPI*                          edf_api;
+    std::vector<void*>                     module_states;
+    std::vector<std::mutex>                state_mutexes;
+    EdfCropImageConfig                     crop_config;
+    EdfClassifyConfig                      classify_config;
+    bool                                   has_crop_config;
+    bool                                   has_classify_config;
+    fcn_edfPipelineDecode                  decode;
+    fcn_edfPipelineRelease                 release;
+    fcn_edfPipelineSink                    sink;
+    void*                                  user_data;
+    std::chrono::milliseconds              max_latency;
+    std::mutex                             mutex;       // guards the queues, streams and counters
+    std::condition_variable                flush_cond;  // signals edfPipelineFlush that no frame is in flight
+    PipelineQueue                          queues[EDF_PIPELINE_NUM_STAGES];
+    std::vector<std::thread>               threads[EDF_PIPELINE_NUM_STAGES];
+    std::map<unsigned int, PipelineStream> streams;
+    unsigned int                           next_state;
+    unsigned long long                     in_flight;
+
+    explicit EdfPipeline(unsigned int num_states) : state_mutexes(num_states) {}
+};
+
+static void releaseFrame(EdfPipeline* pipeline, PipelineItem* item) {
+    if (!item->released) {
+        item->released = true;
+        if (pipeline->release) {
+            pipeline->release(&item->item, pipeline->user_data);
+        }
+    }
+}
+
+static void freeItem(EdfPipeline* pipeline, PipelineItem* item) {
+    releaseFrame(pipeline, item);
+    void*         state = pipeline->module_states[item->state_index];
+    const EdfAPI* api   = pipeline->edf_api;
+    {
+        std::lock_guard<std::mutex> lock(pipeline->state_mutexes[item->state_index]);
+        if (item->has_crop) {
+            api->edfFreeCropImage(state, &item->crop);
+        }
+        edfFreeRecognizeResult(api, &item->item.result, state);
+    }
+    delete item;
+}
+
+// Passes the finished frames of the item stream to the sink in the sequence order.
+static void sinkItem(EdfPipeline* pipeline, PipelineItem* item) {
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    PipelineStream& stream = pipeline->streams[item->item.stream_id];
+    stream.pending[item->item.sequence] = item;
+    if (stream.sinking) {
+        return;
+    }
+    stream.sinking = true;
+    while (!stream.pending.empty() && stream.pending.begin()->first == stream.next_sink) {
+        PipelineItem* next = stream.pending.begin()->second;
+        stream.pending.erase(stream.pending.begin());
+        stream.next_sink++;
+        lock.unlock();
+
+        pipeline->sink(&next->item, pipeline->user_data);
+        freeItem(pipeline, next);
+
+        lock.lock();
+        if (--pipeline->in_flight == 0) {
+            pipeline->flush_cond.notify_all();
+        }
+    }
+    stream.sinking = false;
+}
+
+static void dropItem(EdfPipeline* pipeline, PipelineItem* item, int stage) {
+    item->item.stage   = stage;
+    item->item.dropped = 1;
+    releaseFrame(pipeline, item);
+    sinkItem(pipeline, item);
+}
+
+// Queues the item to the input queue of the stage, applying the overflow policy of the queue when full.
+static void pushItem(EdfPipeline* pipeline, int stage, PipelineItem* item) {
+    PipelineQueue& queue  = pipeline->queues[stage];
+    PipelineItem*  victim = NULL;
+    {
+        std::unique_lock<std::mutex> lock(pipeline->mutex);
+        if (queue.items.size() >= queue.capacity) {
+            if (queue.overflow == EDF_PIPELINE_DROP_OLDEST) {
+                victim = queue.items.front();
+                queue.items.pop_front();
+            } else if (queue.overflow == EDF_PIPELINE_DROP_NEWEST) {
+                victim = item;
+                item   = NULL;
+            } else {
+                queue.not_full.wait(lock, [&queue]() { return queue.items.size() < queue.capacity; });
+            }
+        }
+        if (victim) {
+            queue.stats.dropped++;
+        }
+        if (item) {
+            queue.items.push_back(item);
+            if (queue.items.size() > queue.stats.queue_peak) {
+                queue.stats.queue_peak = (unsigned int)queue.items.size();
+            }
+            queue.not_empty.notify_one();
+        }
+    }
+    if (victim) {
+        dropItem(pipeline, victim, stage);
+    }
+}
+
+// Takes the next item of the stage, returns NULL when the queue is closed and empty.
+static PipelineItem* popItem(EdfPipeline* pipeline, int stage) {
+    PipelineQueue&               queue = pipeline->queues[stage];
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    queue.not_empty.wait(lock, [&queue]() { return !queue.items.empty() || queue.closed; });
+    if (queue.items.empty()) {
+        return NULL;
+    }
+    PipelineItem* item = queue.items.front();
+    queue.items.pop_front();
+    queue.not_full.notify_one();
+    return item;
+}
+
+static int runStage(EdfPipeline* pipeline, int stage, PipelineItem* item) {
+    const EdfAPI* api   = pipeline->edf_api;
+    void*         state = pipeline->module_states[item->state_index];
+    int           code  = 0;
+    if (stage == EDF_PIPELINE_DECODE) {
+        return pipeline->decode(&item->item, pipeline->user_data);
+    }
+    std::lock_guard<std::mutex> lock(pipeline->state_mutexes[item->state_index]);
+    switch (stage) {
+    case EDF_PIPELINE_CROP:
+        code = api->edfCropImage(&item->item.image, &item->item.crop_params, state, &item->crop,
+                                 pipeline->has_crop_config ? &pipeline->crop_config : NULL);
+        item->has_crop = code == 0;
+        break;
+    case EDF_PIPELINE_DESC:
+        code = api->edfComputeDesc(&item->crop, state, &item->item.result.descriptor, NULL);
+        api->edfFreeCropImage(state, &item->crop);
+        item->has_crop = false;
+        break;
+    case EDF_PIPELINE_CLASSIFY:
+        code = api->edfClassify(&item->item.result.descriptor, state, &item->item.result.classify_result,
+                                pipeline->has_classify_config ? &pipeline->classify_config : NULL);
+        break;
+    }
+    return code;
+}
+
+static void stageWorker(EdfPipeline* pipeline, int stage) {
+    PipelineQueue& queue = pipeline->queues[stage];
+    PipelineItem*  item  = NULL;
+    while ((item = popItem(pipeline, stage)) != NULL) {
+        if (stage == EDF_PIPELINE_SINK) {
+            {
+                std::lock_guard<std::mutex> lock(pipeline->mutex);
+                queue.stats.processed++;
+            }
+            sinkItem(pipeline, item);
+            continue;
+        }
+        std::chrono::steady_clock::duration age = std::chrono::steady_clock::now() - item->pushed;
+        if (pipeline->max_latency.count() > 0 && age > pipeline->max_latency) {
+            // Stale frame, its result would come too late.
+            {
+                std::lock_guard<std::mutex> lock(pipeline->mutex);
+                queue.stats.dropped++;
+            }
+            item->item.code = EDF_ERROR_DEADLINE_EXCEEDED;
+            dropItem(pipeline, item, stage);
+            continue;
+        }
+        int code = runStage(pipeline, stage, item);
+        if (stage == EDF_PIPELINE_CROP) {
+            // The image is not needed by the later stages.
+            releaseFrame(pipeline, item);
+        }
+        {
+            std::lock_guard<std::mutex> lock(pipeline->mutex);
+            queue.stats.processed++;
+            if (code != 0) {
+                queue.stats.failed++;
+            }
+        }
+        if (code != 0) {
+            item->item.stage = stage;
+            item->item.code  = code;
+            releaseFrame(pipeline, item);
+            sinkItem(pipeline, item);
+        } else {
+            pushItem(pipeline, stage + 1, item);
+        }
+    }
+}
+
+int edfPipelineCreate(const EdfAPI* edf_api, const EdfPipelineConfig* config, void** pipeline) {
+    if (!edf_api || !config || !config->module_states || config->num_module_states == 0 || !config->decode ||
+        !config->sink || !pipeline) {
+        return -1;
+    }
+    for (unsigned int i = 0; i < config->num_module_states; i++) {
+        if (!config->module_states[i]) {
+            return -1;
+        }
+    }
+    EdfPipeline* state = new EdfPipeline(config->num_module_states);
+    state->edf_api     = edf_api;
+    state->module_states.assign(config->module_states, config->module_states + config->num_module_states);
+    state->has_crop_config     = config->crop_config != NULL;
+    state->has_classify_config = config->classify_config != NULL;
+    if (config->crop_config) {
+        state->crop_config = *config->crop_config;
+    }
+    if (config->classify_config) {
+        state->classify_config = *config->classify_config;
+    }
+    state->decode      = config->decode;
+    state->release     = config->release;
+    state->sink        = config->sink;
+    state->user_data   = config->user_data;
+    state->max_latency = std::chrono::milliseconds(config->max_latency_ms);
+    state->next_state  = 0;
+    state->in_flight   = 0;
+    for (int stage = 0; stage < EDF_PIPELINE_NUM_STAGES; stage++) {
+        const EdfPipelineStageConfig& stage_config = config->stages[stage];
+        unsigned int   num_threads = stage_config.num_threads > 0 ? stage_config.num_threads : 1;
+        PipelineQueue& queue       = state->queues[stage];
+        queue.capacity = stage_config.queue_capacity > 0 ? stage_config.queue_capacity : 2 * num_threads;
+        queue.overflow = stage_config.overflow;
+        queue.closed   = false;
+        memset(&queue.stats, 0, sizeof(EdfPipelineStageStats));
+        for (unsigned int i = 0; i < num_threads; i++) {
+            state->threads[stage].push_back(std::thread(stageWorker, state, stage));
+        }
+    }
+    *pipeline = state;
+    return 0;
+}
+
+void edfPipelineFree(void** pipeline) {
+    if (!pipeline || !*pipeline) {
+        return;
+    }
+    EdfPipeline* state = (EdfPipeline*)*pipeline;
+    // Stop the stages in the processing order, each stage finishes its queue before the next one is closed.
+    for (int stage = 0; stage < EDF_PIPELINE_NUM_STAGES; stage++) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->queues[stage].closed = true;
+            state->queues[stage].not_empty.notify_all();
+        }
+        for (size_t i = 0; i < state->threads[stage].size(); i++) {
+            state->threads[stage][i].join();
+        }
+    }
+    delete state;
+    *pipeline = NULL;
+}
+
+int edfPipelinePush(void* pipeline, unsigned int stream_id, void* frame, unsigned long long* sequence) {
+    if (!pipeline) {
+        return -1;
+    }
+    EdfPipeline*  state = (EdfPipeline*)pipeline;
+    PipelineItem* item  = new PipelineItem();
+    memset(&item->item, 0, sizeof(EdfPipelineItem));
+    memset(&item->crop, 0, sizeof(ERImage));
+    item->item.stream_id = stream_id;
+    item->item.frame     = frame;
+    item->item.stage     = EDF_PIPELINE_SINK;
+    item->has_crop       = false;
+    item->released       = false;
+    item->pushed         = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        item->item.sequence = state->streams[stream_id].next_push++;
+        item->state_index   = state->next_state;
+        state->next_state   = (state->next_state + 1) % (unsigned int)state->module_states.size();
+        state->in_flight++;
+    }
+    if (sequence) {
+        *sequence = item->item.sequence;
+    }
+    pushItem(state, EDF_PIPELINE_DECODE, item);
+    return 0;
+}
+
+int edfPipelineFlush(void* pipeline) {
+    if (!pipeline) {
+        return -1;
+    }
+    EdfPipeline*                 state = (EdfPipeline*)pipeline;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->flush_cond.wait(lock, [state]() { return state->in_flight == 0; });
+    return 0;
+}
+
+int edfPipelineGetStats(const void* pipeline, EdfPipelineStageStats* stats) {
+    if (!pipeline || !stats) {
+        return -1;
+    }
+    EdfPipeline*                state = (EdfPipeline*)pipeline;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    for (int stage = 0; stage < EDF_PIPELINE_NUM_STAGES; stage++) {
+        stats[stage]            = state->queues[stage].stats;
+        stats[stage].queue_size = (unsigned int)state->queues[stage].items.size();
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include "edf-recognize.h"
+
+// Pipeline stages, in the processing order
+#define EDF_PIPELINE_DECODE     0
+#define EDF_PIPELINE_CROP       1
+#define EDF_PIPELINE_DESC       2
+#define EDF_PIPELINE_CLASSIFY   3
+#define EDF_PIPELINE_SINK       4
+#define EDF_PIPELINE_NUM_STAGES 5
+
+// Overflow policies of the stage input queues
+#define EDF_PIPELINE_BLOCK       0  // the producer waits for a free slot (backpressure)
+#define EDF_PIPELINE_DROP_OLDEST 1  // the oldest queued frame is dropped
+#define EDF_PIPELINE_DROP_NEWEST 2  // the frame being queued is dropped
+
+//////////////////////////////////////////////////////////////
+//      EdfPipelineItem                                     //
+//////////////////////////////////////////////////////////////
+// EdfPipelineItem represents one frame passing through     //
+// the pipeline.                                            //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int       stream_id;          // stream passed to edfPipelinePush
+    unsigned long long sequence;           // frame number within the stream, starting from 0
+    void*              frame;              // user frame passed to edfPipelinePush
+    ERImage            image;              // input image, filled by the decode callback
+    EdfCropParams      crop_params;        // crop parameters, filled by the decode callback
+    int                stage;              // stage the frame failed or was dropped in, EDF_PIPELINE_SINK otherwise
+    int                code;               // 0 on success, error code of the failed stage, EDF_ERROR_DEADLINE_EXCEEDED
+    int                dropped;            // 1 if the frame was dropped by a full queue or max_latency_ms, 0 otherwise
+    EdfRecognizeResult result;             // classification result and descriptor, empty on failure or drop
+} EdfPipelineItem;
+
+// Decode callback. Fills the image and crop parameters of the item from item->frame. Returns 0 on success.
+typedef int (*fcn_edfPipelineDecode)(EdfPipelineItem* item, void* user_data);
+
+// Release callback. Called exactly once per item as soon as the image is not needed (after the crop, or when the
+// item fails or is dropped earlier) to free the frame, image and crop parameters. They are zero if not decoded.
+typedef void (*fcn_edfPipelineRelease)(EdfPipelineItem* item, void* user_data);
+
+// Sink callback. Called once per pushed item in the push order of its stream, dropped and failed items included.
+// Runs on a pipeline thread or on the thread dropping the item, never for two items of one stream at once.
+// The result is freed when the callback returns.
+typedef void (*fcn_edfPipelineSink)(const EdfPipelineItem* item, void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfPipelineStageConfig                              //
+//////////////////////////////////////////////////////////////
+// EdfPipelineStageConfig represents the configuration      //
+// parameters of one pipeline stage.                        //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int num_threads;              // number of threads of the stage, 0 means 1
+    unsigned int queue_capacity;           // capacity of the stage input queue, 0 means 2 * num_threads
+    int          overflow;                 // overflow policy of the input queue, EDF_PIPELINE_BLOCK DEFAULT
+} EdfPipelineStageConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfPipelineConfig                                   //
+//////////////////////////////////////////////////////////////
+// EdfPipelineConfig represents the configuration           //
+// parameters of the streaming pipeline.                    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    void**                 module_states;     // module states, frames are spread over them round-robin
+    unsigned int           num_module_states; // number of module states
+    EdfCropImageConfig*    crop_config;       // image cropping configuration (can be NULL), copied
+    EdfClassifyConfig*     classify_config;   // classification configuration (can be NULL), copied
+    EdfPipelineStageConfig stages[EDF_PIPELINE_NUM_STAGES]; // stage configuration, indexed by EDF_PIPELINE_*
+    fcn_edfPipelineDecode  decode;            // decode callback
+    fcn_edfPipelineRelease release;           // release callback (can be NULL)
+    fcn_edfPipelineSink    sink;              // sink callback
+    void*                  user_data;         // data passed to the callbacks
+    unsigned int           max_latency_ms;    // frames older than this when a stage takes them are dropped, 0 none
+} EdfPipelineConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfPipelineStageStats                               //
+//////////////////////////////////////////////////////////////
+// EdfPipelineStageStats represents the counters of one     //
+// pipeline stage.                                          //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned long long processed;          // frames processed by the stage
+    unsigned long long failed;             // frames failed in the stage
+    unsigned long long dropped;            // frames dropped by the full input queue or max_latency_ms
+    unsigned int       queue_size;         // frames in the input queue now
+    unsigned int       queue_peak;         // maximal number of frames in the input queue
+} EdfPipelineStageStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfPipelineCreate, edfPipelineFree                                                                            //
+//      Creates the streaming pipeline decode -> crop -> descriptor -> classify -> sink and starts the threads of   //
+//      all stages / processes the pushed frames, stops the threads and frees the pipeline. The stages are          //
+//      connected by bounded queues. A module state is used by one thread at a time, the crop, descriptor and       //
+//      classification of a frame use the same module state.                                                        //
+//                                                                                                                  //
+//      input:          edf_api  - pointer to the linked Eyedentify API                                             //
+//                      config   - pipeline configuration                                                           //
+//      output:         pipeline - pointer to the pipeline                                                          //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfPipelineCreate(const EdfAPI* edf_api, const EdfPipelineConfig* config, void** pipeline);
+void edfPipelineFree(void** pipeline);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfPipelinePush                                                                                               //
+//      Queues the frame of the stream to the decode stage. With EDF_PIPELINE_BLOCK the call waits while the        //
+//      decode queue is full, otherwise a frame may be dropped and passed to the sink as dropped. The function is   //
+//      thread-safe, frames of one stream pushed from one thread reach the sink in the push order.                  //
+//                                                                                                                  //
+//      input:          pipeline  - pointer to the pipeline                                                         //
+//                      stream_id - identifier of the stream, e.g. camera number                                    //
+//                      frame     - user frame passed to the decode callback                                        //
+//      output:         sequence  - frame number within the stream (can be NULL)                                    //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfPipelinePush(void* pipeline, unsigned int stream_id, void* frame, unsigned long long* sequence);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfPipelineFlush                                                                                              //
+//      Waits until all pushed frames are passed to the sink.                                                       //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfPipelineFlush(void* pipeline);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfPipelineGetStats                                                                                           //
+//      Returns the counters of all stages.                                                                         //
+//                                                                                                                  //
+//      input:          pipeline - pointer to the pipeline                                                          //
+//      output:         stats    - array of EDF_PIPELINE_NUM_STAGES structures to fill, indexed by EDF_PIPELINE_*   //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfPipelineGetStats(const void* pipeline, EdfPipelineStageStats* stats);
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-planes.h"
+
+#include <string.h>
+
+int edfWrapImagePlanes(const EdfAPI* edf_api, const EdfImagePlanes* planes, ERImage* image) {
+    if (!edf_api || !edf_api->erImageAllocateAndWrap || !planes || !image || !planes->planes[0] ||
+        planes->width == 0 || planes->height == 0 || planes->width % 2 != 0 || planes->height % 2 != 0 ||
+        planes->strides[0] < planes->width) {
+        return -1;
+    }
+    unsigned int width  = planes->width;
+    unsigned int height = planes->height;
+    if (planes->color_model == ER_IMAGE_COLORMODEL_YCBCRNV12) {
+        if (!planes->planes[1] || planes->strides[1] < width) {
+            return -1;
+        }
+    } else if (planes->color_model == ER_IMAGE_COLORMODEL_YCBCR420) {
+        if (!planes->planes[1] || !planes->planes[2]) {
+            return -1;
+        }
+        if (planes->strides[1] != width / 2 || planes->strides[2] != width / 2 || height % 4 != 0) {
+            return -2;
+        }
+    } else {
+        return -1;
+    }
+
+    memset(image, 0, sizeof(ERImage));
+    int code = edf_api->erImageAllocateAndWrap(image, width, height, planes->color_model, ER_IMAGE_DATATYPE_UCHAR,
+                                               planes->planes[0], planes->strides[0]);
+    if (code != 0) {
+        return code;
+    }
+    // Rows [0, height) are the Y plane as wrapped, the chroma rows follow.
+    unsigned char** chroma_rows = image->row_data + height;
+    if (planes->color_model == ER_IMAGE_COLORMODEL_YCBCRNV12) {
+        // One interleaved CbCr row per two Y rows.
+        for (unsigned int i = 0; i < height / 2; i++) {
+            chroma_rows[i] = planes->planes[1] + (size_t)i * planes->strides[1];
+        }
+    } else {
+        // Cb then Cr, each plane of width / 2 x height / 2 bytes forms height / 4 rows of width bytes.
+        for (unsigned int i = 0; i < height / 4; i++) {
+            chroma_rows[i]              = planes->planes[1] + (size_t)i * width;
+            chroma_rows[height / 4 + i] = planes->planes[2] + (size_t)i * width;
+        }
+    }
+    return 0;
+}
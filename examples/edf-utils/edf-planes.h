@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfImagePlanes                                      //
+//////////////////////////////////////////////////////////////
+// EdfImagePlanes describes a planar YCbCr frame as given   //
+// by video decoders, each plane with its own row stride.   //
+//   ER_IMAGE_COLORMODEL_YCBCRNV12: planes Y and CbCr       //
+//   ER_IMAGE_COLORMODEL_YCBCR420:  planes Y, Cb and Cr     //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    ERImageColorModel color_model;       // ER_IMAGE_COLORMODEL_YCBCRNV12 or ER_IMAGE_COLORMODEL_YCBCR420
+    unsigned int      width;             // width of the frame in pixels, even
+    unsigned int      height;            // height of the frame in pixels, even
+    unsigned char*    planes[3];         // pointers to the first rows of the planes, unused planes are NULL
+    unsigned int      strides[3];        // row byte steps of the planes
+} EdfImagePlanes;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfWrapImagePlanes                                                                                            //
+//      Wraps the planes of a YCbCr frame into an ERImage for edfCropImage without copying the pixel data. The      //
+//      image is allocated by erImageAllocateAndWrap over the Y plane and its chroma rows in row_data are pointed   //
+//      into the chroma planes:                                                                                     //
+//        - YCBCRNV12: any Y and CbCr strides.                                                                      //
+//        - YCBCR420:  the Cb and Cr planes must be stored without row padding (stride == width / 2) and the        //
+//                     height must be divisible by 4, as two chroma rows form one row of the image.                 //
+//      The planes must outlive the image. Free the image by erImageFree, the plane data are not freed.             //
+//      ASSUMPTION: the image is a valid edfCropImage input only if the library reads the chroma rows through       //
+//      row_data[height..] and never as one block at data + height * step. Neither is documented by the SDK.        //
+//      Verify it for the used library version, e.g. compare the crop of a wrapped frame to the crop of the same    //
+//      frame copied to one contiguous buffer.                                                                      //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      planes  - pointer to the plane description                                                  //
+//      output:         image   - pointer to the ERImage structure to fill                                          //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments,                                                      //
+//                      -2 if the plane layout cannot be wrapped (copy the planes to one buffer instead),           //
+//                      erImageAllocateAndWrap error code otherwise                                                 //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfWrapImagePlanes(const EdfAPI* edf_api, const EdfImagePlanes* planes, ERImage* image);
@@ -0,0 +1,434 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-pyramid.h"
+
+#include "edf-alloc.h"
+
+#include <edf_type_mmr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDF_PYRAMID_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#define EDF_PYRAMID_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Levels are not built below this width or height
+#define EDF_PYRAMID_MIN_SIZE 16
+
+////////////////////////////////////////////////////////////////////////////////
+// DOWNSCALING KERNELS                                                        //
+////////////////////////////////////////////////////////////////////////////////
+// All kernels compute the width output pixels of c channels (1, 3 or 4) of one output row from two input rows:
+// out[x * c + k] = avg(avg(row0[2 * x * c + k], row1[2 * x * c + k]), avg(row0[2 * x * c + c + k], row1[...])).
+// The SIMD kernels average the rows, deinterleave the pixel pairs in the registers and store the packed output.
+typedef void (*fcn_boxKernel)(const unsigned char*, const unsigned char*, unsigned char*, unsigned int, unsigned int);
+
+static inline unsigned char avgU8(unsigned int a, unsigned int b) {
+    return (unsigned char)((a + b + 1) >> 1);
+}
+
+static void boxKernelScalar(const unsigned char* row0, const unsigned char* row1, unsigned char* out,
+                            unsigned int width, unsigned int c) {
+    size_t n = (size_t)width * c;
+    for (size_t i = 0; i < n; i++) {
+        // Channel k = i % c of output pixel x = i / c is read at 2 * x * c + k = 2 * i - k.
+        size_t j = 2 * i - i % c;
+        out[i] = avgU8(avgU8(row0[j], row1[j]), avgU8(row0[j + c], row1[j + c]));
+    }
+}
+
+#if EDF_PYRAMID_X86
+static inline __m128i avgRows128(const unsigned char* row0, const unsigned char* row1) {
+    return _mm_avg_epu8(_mm_loadu_si128((const __m128i*)row0), _mm_loadu_si128((const __m128i*)row1));
+}
+
+// Two BGR output pixels from 4 input pixels (the load reads 16 bytes), in bytes 0-5 of the result.
+static inline __m128i boxPairBGR(const unsigned char* row0, const unsigned char* row1) {
+    const __m128i first = _mm_setr_epi8(-1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i       v     = avgRows128(row0, row1);
+    __m128i       h     = _mm_avg_epu8(v, _mm_srli_si128(v, 3));
+    // h[0..2] is output pixel 0, h[6..8] is output pixel 1.
+    return _mm_or_si128(_mm_and_si128(h, first), _mm_and_si128(_mm_srli_si128(h, 3), _mm_slli_si128(first, 3)));
+}
+
+// Stores bytes 0-11 of the register.
+static inline void store12(unsigned char* out, __m128i v) {
+    _mm_storel_epi64((__m128i*)out, v);
+    int rest = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    memcpy(out + 8, &rest, 4);
+}
+
+static void boxKernelSSE2(const unsigned char* row0, const unsigned char* row1, unsigned char* out,
+                          unsigned int width, unsigned int c) {
+    unsigned int x = 0;
+    if (c == 1) {
+        // 32 input pixels to 16: average the even and odd bytes as 16-bit lanes and pack them back.
+        const __m128i low = _mm_set1_epi16(0x00FF);
+        for (; x + 16 <= width; x += 16) {
+            __m128i v0 = avgRows128(row0 + 2 * x, row1 + 2 * x);
+            __m128i v1 = avgRows128(row0 + 2 * x + 16, row1 + 2 * x + 16);
+            __m128i h0 = _mm_avg_epu16(_mm_and_si128(v0, low), _mm_srli_epi16(v0, 8));
+            __m128i h1 = _mm_avg_epu16(_mm_and_si128(v1, low), _mm_srli_epi16(v1, 8));
+            _mm_storeu_si128((__m128i*)(out + x), _mm_packus_epi16(h0, h1));
+        }
+    } else if (c == 4) {
+        // 8 input pixels to 4: split the even and odd 32-bit pixels.
+        for (; x + 4 <= width; x += 4) {
+            __m128  v0   = _mm_castsi128_ps(avgRows128(row0 + 8 * x, row1 + 8 * x));
+            __m128  v1   = _mm_castsi128_ps(avgRows128(row0 + 8 * x + 16, row1 + 8 * x + 16));
+            __m128i even = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i odd  = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm_storeu_si128((__m128i*)(out + 4 * x), _mm_avg_epu8(even, odd));
+        }
+    } else if (c == 3) {
+        // 8 input pixels to 4, the second load reads 4 bytes past them.
+        for (; x + 5 <= width; x += 4) {
+            __m128i h0 = boxPairBGR(row0 + 6 * x, row1 + 6 * x);
+            __m128i h1 = boxPairBGR(row0 + 6 * x + 12, row1 + 6 * x + 12);
+            store12(out + 3 * x, _mm_or_si128(h0, _mm_slli_si128(h1, 6)));
+        }
+    }
+    boxKernelScalar(row0 + (size_t)2 * x * c, row1 + (size_t)2 * x * c, out + (size_t)x * c, width - x, c);
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+static void boxKernelAVX2(const unsigned char* row0, const unsigned char* row1, unsigned char* out,
+                          unsigned int width, unsigned int c) {
+    unsigned int x = 0;
+    if (c == 1) {
+        // 64 input pixels to 32, the 128-bit lanes of the pack are reordered by the permute.
+        const __m256i low = _mm256_set1_epi16(0x00FF);
+        for (; x + 32 <= width; x += 32) {
+            __m256i v0 = _mm256_avg_epu8(_mm256_loadu_si256((const __m256i*)(row0 + 2 * x)),
+                                         _mm256_loadu_si256((const __m256i*)(row1 + 2 * x)));
+            __m256i v1 = _mm256_avg_epu8(_mm256_loadu_si256((const __m256i*)(row0 + 2 * x + 32)),
+                                         _mm256_loadu_si256((const __m256i*)(row1 + 2 * x + 32)));
+            __m256i h0 = _mm256_avg_epu16(_mm256_and_si256(v0, low), _mm256_srli_epi16(v0, 8));
+            __m256i h1 = _mm256_avg_epu16(_mm256_and_si256(v1, low), _mm256_srli_epi16(v1, 8));
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(h0, h1), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(out + x), packed);
+        }
+    } else if (c == 4) {
+        // 16 input pixels to 8, the 128-bit lanes of the shuffle are reordered by the permute.
+        for (; x + 8 <= width; x += 8) {
+            __m256  v0 = _mm256_castsi256_ps(_mm256_avg_epu8(_mm256_loadu_si256((const __m256i*)(row0 + 8 * x)),
+                                                             _mm256_loadu_si256((const __m256i*)(row1 + 8 * x))));
+            __m256  v1 = _mm256_castsi256_ps(_mm256_avg_epu8(_mm256_loadu_si256((const __m256i*)(row0 + 8 * x + 32)),
+                                                             _mm256_loadu_si256((const __m256i*)(row1 + 8 * x + 32))));
+            __m256i even = _mm256_castps_si256(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m256i odd  = _mm256_castps_si256(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+            __m256i box  = _mm256_permute4x64_epi64(_mm256_avg_epu8(even, odd), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(out + 4 * x), box);
+        }
+    } else if (c == 3) {
+        // 8 input pixels (24 bytes, loaded as bytes 0-15 and 8-23) to 4, the left and right pixels of the pairs are
+        // gathered by byte shuffles.
+        const __m128i left_a  = _mm_setr_epi8(0, 1, 2, 6, 7, 8, 12, 13, 14, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i left_b  = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, 10, 11, 12, -1, -1, -1, -1);
+        const __m128i right_a = _mm_setr_epi8(3, 4, 5, 9, 10, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i right_b = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, 8, 9, 13, 14, 15, -1, -1, -1, -1);
+        for (; x + 4 <= width; x += 4) {
+            __m128i va    = avgRows128(row0 + 6 * x, row1 + 6 * x);
+            __m128i vb    = avgRows128(row0 + 6 * x + 8, row1 + 6 * x + 8);
+            __m128i left  = _mm_or_si128(_mm_shuffle_epi8(va, left_a), _mm_shuffle_epi8(vb, left_b));
+            __m128i right = _mm_or_si128(_mm_shuffle_epi8(va, right_a), _mm_shuffle_epi8(vb, right_b));
+            store12(out + 3 * x, _mm_avg_epu8(left, right));
+        }
+    }
+    boxKernelSSE2(row0 + (size_t)2 * x * c, row1 + (size_t)2 * x * c, out + (size_t)x * c, width - x, c);
+}
+
+static bool cpuHasAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    // OSXSAVE and AVX, then the OS must save the YMM registers.
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__)
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+#if EDF_PYRAMID_NEON
+// Pairwise sum of the pixel pairs and rounding halving narrow, (a + b + 1) >> 1 as avgU8.
+static inline uint8x8_t pairAvgNEON(uint8x16_t a, uint8x16_t b) {
+    return vrshrn_n_u16(vpaddlq_u8(vrhaddq_u8(a, b)), 1);
+}
+
+static void boxKernelNEON(const unsigned char* row0, const unsigned char* row1, unsigned char* out,
+                          unsigned int width, unsigned int c) {
+    unsigned int x = 0;
+    if (c == 1) {
+        for (; x + 8 <= width; x += 8) {
+            vst1_u8(out + x, pairAvgNEON(vld1q_u8(row0 + 2 * x), vld1q_u8(row1 + 2 * x)));
+        }
+    } else if (c == 3) {
+        // 16 input pixels deinterleaved to channels, 8 output pixels interleaved back by the store.
+        for (; x + 8 <= width; x += 8) {
+            uint8x16x3_t a = vld3q_u8(row0 + 6 * x);
+            uint8x16x3_t b = vld3q_u8(row1 + 6 * x);
+            uint8x8x3_t  box;
+            box.val[0] = pairAvgNEON(a.val[0], b.val[0]);
+            box.val[1] = pairAvgNEON(a.val[1], b.val[1]);
+            box.val[2] = pairAvgNEON(a.val[2], b.val[2]);
+            vst3_u8(out + 3 * x, box);
+        }
+    } else if (c == 4) {
+        for (; x + 8 <= width; x += 8) {
+            uint8x16x4_t a = vld4q_u8(row0 + 8 * x);
+            uint8x16x4_t b = vld4q_u8(row1 + 8 * x);
+            uint8x8x4_t  box;
+            box.val[0] = pairAvgNEON(a.val[0], b.val[0]);
+            box.val[1] = pairAvgNEON(a.val[1], b.val[1]);
+            box.val[2] = pairAvgNEON(a.val[2], b.val[2]);
+            box.val[3] = pairAvgNEON(a.val[3], b.val[3]);
+            vst4_u8(out + 4 * x, box);
+        }
+    }
+    boxKernelScalar(row0 + (size_t)2 * x * c, row1 + (size_t)2 * x * c, out + (size_t)x * c, width - x, c);
+}
+#endif
+
+static bool simdSupported(int level) {
+    switch (level) {
+    case EDF_SIMD_SCALAR:
+        return true;
+#if EDF_PYRAMID_X86
+    case EDF_SIMD_SSE2:
+        return true;
+    case EDF_SIMD_AVX2:
+        return cpuHasAVX2();
+#endif
+#if EDF_PYRAMID_NEON
+    case EDF_SIMD_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+static int bestSimdLevel() {
+    if (simdSupported(EDF_SIMD_AVX2)) {
+        return EDF_SIMD_AVX2;
+    }
+    if (simdSupported(EDF_SIMD_SSE2)) {
+        return EDF_SIMD_SSE2;
+    }
+    if (simdSupported(EDF_SIMD_NEON)) {
+        return EDF_SIMD_NEON;
+    }
+    return EDF_SIMD_SCALAR;
+}
+
+// Read by every pyramid build, may be switched by another thread at any time (e.g. example-crop-bench).
+static std::atomic<int> g_simd_level(bestSimdLevel());
+
+static fcn_boxKernel boxKernel() {
+    switch (g_simd_level.load(std::memory_order_relaxed)) {
+#if EDF_PYRAMID_X86
+    case EDF_SIMD_SSE2:
+        return boxKernelSSE2;
+    case EDF_SIMD_AVX2:
+        return boxKernelAVX2;
+#endif
+#if EDF_PYRAMID_NEON
+    case EDF_SIMD_NEON:
+        return boxKernelNEON;
+#endif
+    default:
+        return boxKernelScalar;
+    }
+}
+
+int edfPyramidSimdLevel(void) {
+    return g_simd_level.load(std::memory_order_relaxed);
+}
+
+int edfPyramidSetSimdLevel(int level) {
+    if (!simdSupported(level)) {
+        return -1;
+    }
+    g_simd_level.store(level, std::memory_order_relaxed);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PYRAMID                                                                    //
+////////////////////////////////////////////////////////////////////////////////
+
+// Downscales src by 2 into dst, both images have the same color model.
+static void downscale(const ERImage* src, ERImage* dst, unsigned int channels) {
+    fcn_boxKernel kernel = boxKernel();
+    for (unsigned int y = 0; y < dst->height; y++) {
+        kernel(src->row_data[2 * y], src->row_data[2 * y + 1], dst->row_data[y], dst->width, channels);
+    }
+}
+
+static void releaseLevels(const EdfAPI* edf_api, EdfImagePyramid* pyramid) {
+    for (unsigned int i = 0; i < pyramid->num_levels; i++) {
+        edf_api->erImageFree(&pyramid->levels[i]);
+    }
+    pyramid->num_levels = 0;
+}
+
+int edfBuildImagePyramid(const EdfAPI* edf_api, const ERImage* image, const EdfPyramidConfig* config,
+                         EdfImagePyramid* pyramid) {
+    if (!edf_api || !image || !config || !pyramid || config->num_levels > EDF_PYRAMID_MAX_LEVELS) {
+        return -1;
+    }
+    releaseLevels(edf_api, pyramid);
+    pyramid->image  = image;
+    pyramid->config = *config;
+    if (pyramid->config.min_oversampling <= 0.f) {
+        pyramid->config.min_oversampling = 2.f;
+    }
+    if (image->data_type != ER_IMAGE_DATATYPE_UCHAR ||
+        (image->color_model != ER_IMAGE_COLORMODEL_GRAY && image->color_model != ER_IMAGE_COLORMODEL_BGR &&
+         image->color_model != ER_IMAGE_COLORMODEL_BGRA)) {
+        return -2;
+    }
+    unsigned int channels = image->color_model == ER_IMAGE_COLORMODEL_GRAY  ? 1
+                          : image->color_model == ER_IMAGE_COLORMODEL_BGRA  ? 4
+                                                                             : 3;
+    const ERImage* src = image;
+    for (unsigned int i = 0; i < config->num_levels; i++) {
+        unsigned int width  = src->width / 2;
+        unsigned int height = src->height / 2;
+        if (width < EDF_PYRAMID_MIN_SIZE || height < EDF_PYRAMID_MIN_SIZE) {
+            break;
+        }
+        unsigned int step = (width * channels + EDF_MEMORY_ALIGNMENT - 1) / EDF_MEMORY_ALIGNMENT * EDF_MEMORY_ALIGNMENT;
+        size_t       size = (size_t)step * height;
+        if (pyramid->data_capacity[i] < size) {
+            edfFreeAligned(pyramid->data[i]);
+            pyramid->data[i]          = (unsigned char*)edfAllocAligned(size);
+            pyramid->data_capacity[i] = pyramid->data[i] ? size : 0;
+            if (!pyramid->data[i]) {
+                releaseLevels(edf_api, pyramid);
+                return -3;
+            }
+        }
+        ERImage* dst = &pyramid->levels[i];
+        memset(dst, 0, sizeof(ERImage));
+        int code = edf_api->erImageAllocateAndWrap(dst, width, height, image->color_model, ER_IMAGE_DATATYPE_UCHAR,
+                                                   pyramid->data[i], step);
+        if (code != 0) {
+            releaseLevels(edf_api, pyramid);
+            return code;
+        }
+        pyramid->num_levels++;
+        downscale(src, dst, channels);
+        src = dst;
+    }
+    return 0;
+}
+
+// Returns the ratio of the vehicle size to the crop size, 0 if unknown.
+static double vehicleOversampling(const EdfImagePyramid* pyramid, const EdfCropParams* params) {
+    if (params->points.length == EDF_MMRBOX_CROP_POINTS && params->values.length == EDF_MMRBOX_CROP_VALUES) {
+        double width  = std::fabs(EDF_MMRBOX_BOTTOM_RIGHT_X((*params)) - EDF_MMRBOX_TOP_LEFT_X((*params)));
+        double height = std::fabs(EDF_MMRBOX_BOTTOM_RIGHT_Y((*params)) - EDF_MMRBOX_TOP_LEFT_Y((*params)));
+        return std::min(width / pyramid->crop_width, height / pyramid->crop_height);
+    }
+    if (params->points.length == EDF_MMR_CROP_POINTS && params->values.length == EDF_MMR_CROP_VALUES &&
+        pyramid->config.lp_crop_px_per_m > 0.0) {
+        return EDF_LP_SCALE_PX_PER_M((*params)) / pyramid->config.lp_crop_px_per_m;
+    }
+    return 0.0;
+}
+
+int edfCropImagePyramid(const EdfAPI* edf_api, EdfImagePyramid* pyramid, EdfCropParams* params, void* module_state,
+                        ERImage* cropped_image, EdfCropImageConfig* config) {
+    if (!edf_api || !pyramid || !pyramid->image || !params || !cropped_image) {
+        return -1;
+    }
+    unsigned int level = 0;
+    if (pyramid->crop_width > 0 && pyramid->crop_height > 0) {
+        double ratio = vehicleOversampling(pyramid, params);
+        while (level < pyramid->num_levels && ratio / 2.0 >= pyramid->config.min_oversampling) {
+            ratio /= 2.0;
+            level++;
+        }
+    }
+    if (level == 0) {
+        int code = edf_api->edfCropImage(pyramid->image, params, module_state, cropped_image, config);
+        if (code == 0) {
+            pyramid->crop_width  = cropped_image->width;
+            pyramid->crop_height = cropped_image->height;
+        }
+        return code;
+    }
+
+    // Pixel centers: pixel x of the level covers pixels [2^level * x, 2^level * (x + 1)) of the input image.
+    double scale = 1.0 / (1 << level);
+    std::vector<double> rows(params->points.rows, params->points.rows + params->points.length);
+    std::vector<double> cols(params->points.cols, params->points.cols + params->points.length);
+    std::vector<double> values(params->values.values, params->values.values + params->values.length);
+    for (size_t i = 0; i < rows.size(); i++) {
+        rows[i] = (rows[i] + 0.5) * scale - 0.5;
+        cols[i] = (cols[i] + 0.5) * scale - 0.5;
+    }
+    EdfCropParams scaled;
+    scaled.points.length = params->points.length;
+    scaled.points.rows   = rows.empty() ? NULL : &rows[0];
+    scaled.points.cols   = cols.empty() ? NULL : &cols[0];
+    scaled.values.length = params->values.length;
+    scaled.values.values = values.empty() ? NULL : &values[0];
+    if (scaled.points.length == EDF_MMR_CROP_POINTS && scaled.values.length == EDF_MMR_CROP_VALUES) {
+        EDF_LP_SCALE_PX_PER_M(scaled) *= scale;
+    }
+    return edf_api->edfCropImage(&pyramid->levels[level - 1], &scaled, module_state, cropped_image, config);
+}
+
+void edfFreeImagePyramid(const EdfAPI* edf_api, EdfImagePyramid* pyramid) {
+    if (!edf_api || !pyramid) {
+        return;
+    }
+    releaseLevels(edf_api, pyramid);
+    for (unsigned int i = 0; i < EDF_PYRAMID_MAX_LEVELS; i++) {
+        edfFreeAligned(pyramid->data[i]);
+    }
+    memset(pyramid, 0, sizeof(EdfImagePyramid));
+}
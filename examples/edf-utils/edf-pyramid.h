@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+#include <stddef.h>
+
+// Maximal number of downscaled levels of the pyramid
+#define EDF_PYRAMID_MAX_LEVELS 4
+
+// Instruction sets of the downscaling kernel
+typedef enum {
+    EDF_SIMD_SCALAR = 0,                 // plain C++
+    EDF_SIMD_SSE2   = 1,                 // x86 SSE2, 16 output bytes per iteration
+    EDF_SIMD_AVX2   = 2,                 // x86 AVX2, 32 output bytes per iteration
+    EDF_SIMD_NEON   = 3                  // ARM NEON, 8 output pixels per iteration
+} EdfSimdLevel;
+
+//////////////////////////////////////////////////////////////
+//      EdfPyramidConfig                                    //
+//////////////////////////////////////////////////////////////
+// EdfPyramidConfig represents the configuration            //
+// parameters of the pyramid level selection.               //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int num_levels;             // number of downscaled levels to build, at most EDF_PYRAMID_MAX_LEVELS
+    float        min_oversampling;       // minimal ratio of the vehicle size in the used level to the crop size
+                                         // Set to 0.0f to use the default value 2.0f. DEFAULT
+    double       lp_crop_px_per_m;       // LP resolution in px/m at which the LP crop is not rescaled
+                                         // Set to 0.0 to not downscale LP crops. DEFAULT
+} EdfPyramidConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfImagePyramid                                     //
+//////////////////////////////////////////////////////////////
+// EdfImagePyramid holds the input image downscaled by 2,   //
+// 4, ... for cheaper cropping of large frames. Zero the    //
+// structure before the first use, it is reused by next     //
+// edfBuildImagePyramid calls and freed by                  //
+// edfFreeImagePyramid.                                     //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfPyramidConfig config;                                 // configuration passed to edfBuildImagePyramid
+    const ERImage*   image;                                  // input image (level 0), not owned
+    unsigned int     num_levels;                             // number of valid downscaled levels
+    ERImage          levels[EDF_PYRAMID_MAX_LEVELS];         // levels[i] is the input image downscaled by 2^(i+1)
+    unsigned char*   data[EDF_PYRAMID_MAX_LEVELS];           // aligned buffers of the levels
+    size_t           data_capacity[EDF_PYRAMID_MAX_LEVELS];  // allocated byte sizes of the buffers
+    unsigned int     crop_width;                             // crop size of the module, known after the first crop
+    unsigned int     crop_height;
+} EdfImagePyramid;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfBuildImagePyramid                                                                                          //
+//      Builds the downscaled levels of the input image by 2x2 box filtering, which is both the antialiasing and    //
+//      the resampling step of a 2x downscale. The kernel is vectorised and selected at runtime by the CPU          //
+//      features (AVX2, SSE2 or NEON). Levels smaller than 16 pixels are not built.                                 //
+//      Supported inputs are ER_IMAGE_COLORMODEL_GRAY, _BGR and _BGRA images with ER_IMAGE_DATATYPE_UCHAR.          //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      image   - pointer to the input image, it must outlive the pyramid use                       //
+//                      config  - pyramid configuration                                                             //
+//      output:         pyramid - pointer to the pyramid to fill                                                    //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 on unsupported image format,                      //
+//                      -3 on memory allocation failure                                                             //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfBuildImagePyramid(const EdfAPI* edf_api, const ERImage* image, const EdfPyramidConfig* config,
+                         EdfImagePyramid* pyramid);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCropImagePyramid                                                                                           //
+//      Crops the vehicle from the smallest pyramid level in which the vehicle is still at least                    //
+//      config.min_oversampling times larger than the crop. The crop parameters are rescaled to the level, the      //
+//      passed parameters are not changed. The vehicle size is given by the box of MMRBOX parameters and by the     //
+//      LP resolution relative to config.lp_crop_px_per_m for LP parameters. The first crop is always done from     //
+//      level 0 to learn the crop size of the module.                                                               //
+//      See edfCropImage for the description of the other arguments and the return values.                          //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      pyramid - pointer to the pyramid built by edfBuildImagePyramid                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCropImagePyramid(const EdfAPI* edf_api, EdfImagePyramid* pyramid, EdfCropParams* params, void* module_state,
+                        ERImage* cropped_image, EdfCropImageConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeImagePyramid                                                                                           //
+//      Frees all buffers of the pyramid and zeroes the structure.                                                  //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      pyramid - pointer to the pyramid                                                            //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeImagePyramid(const EdfAPI* edf_api, EdfImagePyramid* pyramid);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfPyramidSimdLevel, edfPyramidSetSimdLevel                                                                   //
+//      Returns / overrides the instruction set used by the downscaling kernel, e.g. for benchmarking. The level    //
+//      can be switched while other threads build pyramids, a running build may keep the previous level.            //
+//                                                                                                                  //
+//      input:          level - one of EdfSimdLevel values                                                          //
+//                                                                                                                  //
+//      return value:   edfPyramidSetSimdLevel: 0 on success, -1 if the level is not supported by the CPU           //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfPyramidSimdLevel(void);
+int edfPyramidSetSimdLevel(int level);
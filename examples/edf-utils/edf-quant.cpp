@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-quant.h"
+
+#include "edf-alloc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Maximal number of descriptor pairs used by edfQuantCalibrate
+#define EDF_QUANT_CALIBRATION_PAIRS 100000
+// Minimal correlation of the float cosine similarity with edfCompareDescs accepted by edfQuantCalibrate
+#define EDF_QUANT_MIN_LAYOUT_CORRELATION 0.9
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define EDF_POPCOUNT64(x) (unsigned int)__popcnt64(x)
+#else
+#define EDF_POPCOUNT64(x) (unsigned int)__builtin_popcountll(x)
+#endif
+
+static float norm(const float* values, unsigned int dim) {
+    float sum = 0.f;
+    for (unsigned int i = 0; i < dim; i++) {
+        sum += values[i] * values[i];
+    }
+    return std::sqrt(sum);
+}
+
+static int dotInt8(const signed char* a, const signed char* b, unsigned int dim) {
+    // Plain loop of 32-bit accumulations is auto-vectorized by the compiler (pmaddwd / sdot).
+    int sum = 0;
+    for (unsigned int i = 0; i < dim; i++) {
+        sum += (int)a[i] * (int)b[i];
+    }
+    return sum;
+}
+
+static float dotFloatInt8(const float* a, const signed char* b, unsigned int dim) {
+    float sum = 0.f;
+    for (unsigned int i = 0; i < dim; i++) {
+        sum += a[i] * (float)b[i];
+    }
+    return sum;
+}
+
+static unsigned int hamming(const unsigned char* a, const unsigned char* b, unsigned int size) {
+    unsigned int distance = 0;
+    unsigned int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        unsigned long long word_a, word_b;
+        memcpy(&word_a, a + i, 8);
+        memcpy(&word_b, b + i, 8);
+        distance += EDF_POPCOUNT64(word_a ^ word_b);
+    }
+    for (; i < size; i++) {
+        distance += EDF_POPCOUNT64((unsigned long long)(a[i] ^ b[i]));
+    }
+    return distance;
+}
+
+static float dotFloatBinary(const float* a, const unsigned char* bits, unsigned int dim) {
+    float sum = 0.f;
+    for (unsigned int i = 0; i < dim; i++) {
+        sum += ((bits[i >> 3] >> (i & 7)) & 1) ? a[i] : -a[i];
+    }
+    return sum;
+}
+
+static float applyCalibration(float similarity, const EdfQuantCalibration* calibration) {
+    return calibration ? calibration->scale * similarity + calibration->offset : similarity;
+}
+
+static float quantSimilarity(const EdfQuantDesc* a, const EdfQuantDesc* b) {
+    if (a->norm == 0.f || b->norm == 0.f) {
+        return 0.f;
+    }
+    if (a->type == EDF_QUANT_INT8) {
+        int dot = dotInt8((const signed char*)a->data, (const signed char*)b->data, a->dim);
+        return (float)dot * a->scale * b->scale / (a->norm * b->norm);
+    }
+    // Angle between two vectors is estimated by the fraction of differing signs.
+    const float pi = 3.14159265358979f;
+    return std::cos(pi * (float)hamming(a->data, b->data, a->size) / (float)a->dim);
+}
+
+static float asymmetricSimilarity(const float* values, float values_norm, const EdfQuantDesc* b) {
+    if (values_norm == 0.f || b->norm == 0.f) {
+        return 0.f;
+    }
+    if (b->type == EDF_QUANT_INT8) {
+        return dotFloatInt8(values, (const signed char*)b->data, b->dim) * b->scale / (values_norm * b->norm);
+    }
+    // The reconstructed vector is scale * sign, its norm is scale * sqrt(dim) and the scale cancels out.
+    return dotFloatBinary(values, b->data, b->dim) / (values_norm * std::sqrt((float)b->dim));
+}
+
+// Cosine similarity of the descriptors read as float vectors.
+static float floatCosine(const EdfDescriptor* a, const EdfDescriptor* b) {
+    unsigned int dim = a->size / sizeof(float);
+    std::vector<float> values_a(dim), values_b(dim);
+    memcpy(&values_a[0], a->data, dim * sizeof(float));
+    memcpy(&values_b[0], b->data, dim * sizeof(float));
+    float norm_ab = norm(&values_a[0], dim) * norm(&values_b[0], dim);
+    if (norm_ab == 0.f) {
+        return 0.f;
+    }
+    float dot = 0.f;
+    for (unsigned int i = 0; i < dim; i++) {
+        dot += values_a[i] * values_b[i];
+    }
+    return dot / norm_ab;
+}
+
+// Pearson correlation of the two series, 0 if one of them is constant.
+static double correlation(const std::vector<float>& x, const std::vector<float>& y) {
+    double n = (double)x.size();
+    double mean_x = 0.0, mean_y = 0.0;
+    for (size_t p = 0; p < x.size(); p++) {
+        mean_x += x[p];
+        mean_y += y[p];
+    }
+    mean_x /= n;
+    mean_y /= n;
+    double cov = 0.0, var_x = 0.0, var_y = 0.0;
+    for (size_t p = 0; p < x.size(); p++) {
+        cov += (x[p] - mean_x) * (y[p] - mean_y);
+        var_x += (x[p] - mean_x) * (x[p] - mean_x);
+        var_y += (y[p] - mean_y) * (y[p] - mean_y);
+    }
+    return var_x > 0.0 && var_y > 0.0 ? cov / std::sqrt(var_x * var_y) : 0.0;
+}
+
+int edfQuantizeDesc(const EdfDescriptor* desc, EdfQuantType type, EdfQuantDesc* quant_desc) {
+    if (!desc || !desc->data || !quant_desc || (type != EDF_QUANT_INT8 && type != EDF_QUANT_BINARY)) {
+        return -1;
+    }
+    if (desc->size == 0 || desc->size % sizeof(float) != 0) {
+        return -2;
+    }
+    unsigned int dim = desc->size / sizeof(float);
+    std::vector<float> values(dim);
+    memcpy(&values[0], desc->data, desc->size);
+    for (unsigned int i = 0; i < dim; i++) {
+        if (!std::isfinite(values[i])) {
+            // Not a float vector.
+            return -2;
+        }
+    }
+
+    quant_desc->type    = type;
+    quant_desc->version = desc->version;
+    quant_desc->dim     = dim;
+    quant_desc->size    = type == EDF_QUANT_INT8 ? dim : (dim + 7) / 8;
+    quant_desc->norm    = norm(&values[0], dim);
+    quant_desc->data    = (unsigned char*)edfAllocAligned(quant_desc->size);
+    if (!quant_desc->data) {
+        return -1;
+    }
+    memset(quant_desc->data, 0, quant_desc->size);
+
+    if (type == EDF_QUANT_INT8) {
+        // Symmetric per-descriptor scale, the largest element maps to +-127.
+        float max_abs = 0.f;
+        for (unsigned int i = 0; i < dim; i++) {
+            max_abs = std::max(max_abs, std::fabs(values[i]));
+        }
+        quant_desc->scale = max_abs > 0.f ? max_abs / 127.f : 1.f;
+        signed char* codes = (signed char*)quant_desc->data;
+        for (unsigned int i = 0; i < dim; i++) {
+            long code = std::lround(values[i] / quant_desc->scale);
+            codes[i] = (signed char)std::max(-127L, std::min(127L, code));
+        }
+    } else {
+        float abs_sum = 0.f;
+        for (unsigned int i = 0; i < dim; i++) {
+            abs_sum += std::fabs(values[i]);
+            if (values[i] >= 0.f) {
+                quant_desc->data[i >> 3] |= (unsigned char)(1 << (i & 7));
+            }
+        }
+        quant_desc->scale = abs_sum / dim;
+    }
+    return 0;
+}
+
+void edfFreeQuantDesc(EdfQuantDesc* quant_desc) {
+    if (quant_desc && quant_desc->data) {
+        edfFreeAligned(quant_desc->data);
+        quant_desc->data = NULL;
+        quant_desc->size = 0;
+    }
+}
+
+int edfCompareQuantDescs(const EdfQuantDesc* quant_A, const EdfQuantDesc* quant_B,
+                         const EdfQuantCalibration* calibration, float* score) {
+    if (!quant_A || !quant_B || !quant_A->data || !quant_B->data || !score) {
+        return -1;
+    }
+    if (quant_A->type != quant_B->type || quant_A->version != quant_B->version || quant_A->dim != quant_B->dim) {
+        return -2;
+    }
+    *score = applyCalibration(quantSimilarity(quant_A, quant_B), calibration);
+    return 0;
+}
+
+int edfCompareDescQuantDesc(const EdfDescriptor* desc, const EdfQuantDesc* quant_desc,
+                            const EdfQuantCalibration* calibration, float* score) {
+    if (!desc || !desc->data || !quant_desc || !quant_desc->data || !score) {
+        return -1;
+    }
+    if (desc->version != quant_desc->version || desc->size != quant_desc->dim * sizeof(float)) {
+        return -2;
+    }
+    // Descriptors allocated by the SDK are aligned, copy only misaligned user buffers.
+    const float* values = (const float*)desc->data;
+    std::vector<float> aligned_values;
+    if ((size_t)desc->data % sizeof(float) != 0) {
+        aligned_values.resize(quant_desc->dim);
+        memcpy(&aligned_values[0], desc->data, desc->size);
+        values = &aligned_values[0];
+    }
+    float similarity = asymmetricSimilarity(values, norm(values, quant_desc->dim), quant_desc);
+    *score = applyCalibration(similarity, calibration);
+    return 0;
+}
+
+int edfQuantCalibrate(const EdfAPI* edf_api, const void* module_state, const EdfDescriptor* descs,
+                      unsigned int num_descs, EdfQuantType type, int asymmetric, EdfQuantCalibration* calibration) {
+    if (!edf_api || !edf_api->edfCompareDescs || !module_state || !descs || num_descs < 3 || !calibration) {
+        return -1;
+    }
+    std::vector<EdfQuantDesc> quants(num_descs);
+    unsigned int num_quants = 0;
+    int code = 0;
+    while (num_quants < num_descs) {
+        code = edfQuantizeDesc(&descs[num_quants], type, &quants[num_quants]);
+        if (code != 0) {
+            break;
+        }
+        num_quants++;
+    }
+
+    // Collect (quantized similarity, reference score, float cosine similarity) triples.
+    std::vector<float> similarities, references, cosines;
+    for (unsigned int i = 0; code == 0 && i < num_descs; i++) {
+        for (unsigned int j = i + 1; code == 0 && j < num_descs && similarities.size() < EDF_QUANT_CALIBRATION_PAIRS; j++) {
+            float reference = 0.f, similarity = 0.f;
+            code = edf_api->edfCompareDescs(&descs[i], &descs[j], module_state, &reference);
+            if (code == 0) {
+                code = asymmetric ? edfCompareDescQuantDesc(&descs[i], &quants[j], NULL, &similarity)
+                                  : edfCompareQuantDescs(&quants[i], &quants[j], NULL, &similarity);
+            }
+            similarities.push_back(similarity);
+            references.push_back(reference);
+            cosines.push_back(code == 0 ? floatCosine(&descs[i], &descs[j]) : 0.f);
+        }
+    }
+    for (unsigned int i = 0; i < num_quants; i++) {
+        edfFreeQuantDesc(&quants[i]);
+    }
+    if (code != 0) {
+        return code;
+    }
+    // The float layout is an assumption, reject descriptors whose float cosine does not follow edfCompareDescs.
+    calibration->layout_correlation = (float)correlation(cosines, references);
+    if (calibration->layout_correlation < EDF_QUANT_MIN_LAYOUT_CORRELATION) {
+        return -3;
+    }
+
+    // Least squares fit of reference = scale * similarity + offset.
+    double n = (double)similarities.size();
+    double mean_s = 0.0, mean_r = 0.0;
+    for (size_t p = 0; p < similarities.size(); p++) {
+        mean_s += similarities[p];
+        mean_r += references[p];
+    }
+    mean_s /= n;
+    mean_r /= n;
+    double cov = 0.0, var = 0.0;
+    for (size_t p = 0; p < similarities.size(); p++) {
+        cov += (similarities[p] - mean_s) * (references[p] - mean_r);
+        var += (similarities[p] - mean_s) * (similarities[p] - mean_s);
+    }
+    calibration->scale  = var > 0.0 ? (float)(cov / var) : 1.f;
+    calibration->offset = (float)(mean_r - calibration->scale * mean_s);
+
+    double error_sum = 0.0, error_max = 0.0;
+    for (size_t p = 0; p < similarities.size(); p++) {
+        double error = std::fabs(applyCalibration(similarities[p], calibration) - references[p]);
+        error_sum += error;
+        error_max = std::max(error_max, error);
+    }
+    calibration->mean_abs_error = (float)(error_sum / n);
+    calibration->max_abs_error  = (float)error_max;
+    return 0;
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfQuantType                                        //
+//////////////////////////////////////////////////////////////
+// Type of the quantized descriptor.                        //
+//////////////////////////////////////////////////////////////
+typedef enum {
+    EDF_QUANT_INT8   = 1,       // one signed byte per element, 4x smaller than float descriptor
+    EDF_QUANT_BINARY = 2        // one sign bit per element, 32x smaller than float descriptor
+} EdfQuantType;
+
+//////////////////////////////////////////////////////////////
+//      EdfQuantDesc                                        //
+//////////////////////////////////////////////////////////////
+// EdfQuantDesc is a compact copy of the EdfDescriptor.     //
+// The source descriptor data are interpreted as an array   //
+// of floats compared by the cosine similarity, the         //
+// quantized descriptor keeps the scale and the norm of     //
+// the source vector for scoring.                           //
+// ASSUMPTION: the SDK does not document the descriptor     //
+// layout. edfQuantizeDesc only checks the size (multiple   //
+// of 4) and the finite values, run edfQuantCalibrate once  //
+// per model to verify the layout against edfCompareDescs   //
+// before relying on the quantized scores.                  //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfQuantType   type;        // type of the quantization
+    unsigned int   version;     // version of the model used to create the source descriptor
+    unsigned int   dim;         // number of elements of the source descriptor
+    unsigned int   size;        // number of bytes in the data array
+    float          scale;       // EDF_QUANT_INT8: element value = code * scale; EDF_QUANT_BINARY: mean absolute element value
+    float          norm;        // L2 norm of the source descriptor
+    unsigned char* data;        // pointer to the quantized data
+} EdfQuantDesc;
+
+//////////////////////////////////////////////////////////////
+//      EdfQuantCalibration                                 //
+//////////////////////////////////////////////////////////////
+// EdfQuantCalibration maps the cosine similarity of        //
+// quantized descriptors to the edfCompareDescs score:      //
+// score = scale * similarity + offset. The errors are      //
+// measured on the calibration set and document the         //
+// tolerance of the quantized scores.                       //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    float scale;                // linear mapping scale
+    float offset;               // linear mapping offset
+    float mean_abs_error;       // mean absolute difference to edfCompareDescs on the calibration set
+    float max_abs_error;        // maximal absolute difference to edfCompareDescs on the calibration set
+    float layout_correlation;   // correlation of the float cosine similarity with edfCompareDescs scores
+} EdfQuantCalibration;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfQuantizeDesc                                                                                               //
+//      Quantizes the descriptor to the compact int8 or binary representation. The data of the quantized            //
+//      descriptor are allocated by this function and must be freed using edfFreeQuantDesc.                         //
+//                                                                                                                  //
+//      input:          desc       - descriptor outputted by edfComputeDesc                                         //
+//                      type       - type of the quantization                                                       //
+//      output:         quant_desc - pointer to the EdfQuantDesc structure to fill                                  //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 descriptor size is not a multiple of float size or the             //
+//                      data contain a non-finite float                                                             //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfQuantizeDesc(const EdfDescriptor* desc, EdfQuantType type, EdfQuantDesc* quant_desc);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeQuantDesc                                                                                              //
+//      Frees the data of the quantized descriptor created by edfQuantizeDesc.                                      //
+//                                                                                                                  //
+//      input:          quant_desc - pointer to the EdfQuantDesc structure                                          //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeQuantDesc(EdfQuantDesc* quant_desc);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCompareQuantDescs                                                                                          //
+//      Compares two quantized descriptors of the same type and version and returns a score. Without calibration    //
+//      the score is the estimated cosine similarity of the source descriptors.                                     //
+//                                                                                                                  //
+//      input:          quant_A, quant_B - quantized descriptors                                                    //
+//                      calibration      - mapping to the edfCompareDescs score (can be NULL)                       //
+//      output:         score            - score of the verification to be filled                                   //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 type, version or size mismatch                                     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCompareQuantDescs(const EdfQuantDesc* quant_A, const EdfQuantDesc* quant_B,
+                         const EdfQuantCalibration* calibration, float* score);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCompareDescQuantDesc                                                                                       //
+//      Asymmetric comparison of the full precision query descriptor with the quantized gallery descriptor.         //
+//      Only the gallery side is quantized, so the score is closer to edfCompareDescs than edfCompareQuantDescs.    //
+//                                                                                                                  //
+//      input:          desc        - query descriptor outputted by edfComputeDesc                                  //
+//                      quant_desc  - quantized gallery descriptor                                                  //
+//                      calibration - mapping to the edfCompareDescs score (can be NULL)                            //
+//      output:         score       - score of the verification to be filled                                        //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch                                           //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCompareDescQuantDesc(const EdfDescriptor* desc, const EdfQuantDesc* quant_desc,
+                            const EdfQuantCalibration* calibration, float* score);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfQuantCalibrate                                                                                             //
+//      Fits the linear mapping of the quantized scores to edfCompareDescs scores on a local set of descriptors     //
+//      and measures the remaining error. All pairs of the set are used (at most 100000 pairs). It also verifies    //
+//      the float layout assumption of EdfQuantDesc: the cosine similarity of the descriptors read as floats must   //
+//      correlate with the edfCompareDescs score (correlation at least 0.9), otherwise the quantization does not    //
+//      fit the model and -3 is returned.                                                                           //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      module_state - pointer to the module state                                                  //
+//                      descs        - array of descriptors outputted by edfComputeDesc                             //
+//                      num_descs    - number of descriptors, at least 3                                            //
+//                      type         - type of the quantization                                                     //
+//                      asymmetric   - 1 to calibrate edfCompareDescQuantDesc, 0 to calibrate edfCompareQuantDescs  //
+//      output:         calibration  - pointer to the EdfQuantCalibration structure to fill                         //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, -3 descriptors are not float vectors     //
+//                      compared by cosine similarity, edfCompareDescs error code otherwise                         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfQuantCalibrate(const EdfAPI* edf_api, const void* module_state, const EdfDescriptor* descs,
+                      unsigned int num_descs, EdfQuantType type, int asymmetric, EdfQuantCalibration* calibration);
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-recognize.h"
+
+#include <string.h>
+
+int edfRecognize(const EdfAPI* edf_api, const ERImage* image, EdfCropParams* crop_params, void* module_state,
+                 EdfRecognizeResult* result, const EdfRecognizeConfig* config) {
+    if (!edf_api || !image || !crop_params || !module_state || !result) {
+        return -1;
+    }
+    memset(result, 0, sizeof(EdfRecognizeResult));
+
+    ERImage crop;
+    memset(&crop, 0, sizeof(ERImage));
+    int code = edf_api->edfCropImage(image, crop_params, module_state, &crop, config ? config->crop_config : NULL);
+    if (code != 0) {
+        return code;
+    }
+    EdfDescriptor descriptor;
+    memset(&descriptor, 0, sizeof(EdfDescriptor));
+    code = edf_api->edfComputeDesc(&crop, module_state, &descriptor, NULL);
+    // The crop is not needed anymore.
+    edf_api->edfFreeCropImage(module_state, &crop);
+    if (code != 0) {
+        return code;
+    }
+    code = edf_api->edfClassify(&descriptor, module_state, &result->classify_result,
+                                config ? config->classify_config : NULL);
+    if (code == 0 && config && config->return_descriptor == EDF_CONFIG_VALUE_ENABLED) {
+        result->descriptor = descriptor;
+    } else {
+        edf_api->edfFreeDesc(&descriptor);
+    }
+    return code;
+}
+
+void edfFreeRecognizeResult(const EdfAPI* edf_api, EdfRecognizeResult* result, void* module_state) {
+    if (!edf_api || !result) {
+        return;
+    }
+    if (result->classify_result) {
+        edf_api->edfFreeClassifyResult(&result->classify_result, module_state);
+    }
+    if (result->descriptor.data) {
+        edf_api->edfFreeDesc(&result->descriptor);
+    }
+    memset(result, 0, sizeof(EdfRecognizeResult));
+}
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+// Error code of a request whose deadline passed before it ran (edf-async.h, edf-pipeline.h)
+#define EDF_ERROR_DEADLINE_EXCEEDED -67856900
+
+//////////////////////////////////////////////////////////////
+//      EdfRecognizeConfig                                  //
+//////////////////////////////////////////////////////////////
+// EdfRecognizeConfig represents the configuration          //
+// parameters of the whole recognition chain.               //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfCropImageConfig* crop_config;       // image cropping configuration (can be NULL)
+    EdfClassifyConfig*  classify_config;   // classification configuration (can be NULL)
+    int                 return_descriptor; // Set to  1 to return the descriptor in EdfRecognizeResult.
+                                           // Set to  0 or -1 to free the descriptor right after the classification. DEFAULT
+} EdfRecognizeConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfRecognizeResult                                  //
+//////////////////////////////////////////////////////////////
+// EdfRecognizeResult represents the result of edfRecognize //
+// Free it using edfFreeRecognizeResult.                    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfClassifyResult* classify_result;   // classification result, see edfClassify
+    EdfDescriptor      descriptor;        // descriptor of the vehicle, data is NULL unless return_descriptor is set
+} EdfRecognizeResult;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfRecognize                                                                                                  //
+//      Runs the whole recognition chain edfCropImage -> edfComputeDesc -> edfClassify for one vehicle in the       //
+//      input image. The intermediate crop is freed as soon as the descriptor is computed, the descriptor is freed  //
+//      right after the classification unless requested. All intermediate data are freed on failure.                //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      image        - pointer to the input image                                                   //
+//                      crop_params  - parameters for the input image alignment (LP or MMRBOX, see edf_type_mmr.h)  //
+//                      module_state - pointer to the module state                                                  //
+//                      config       - recognition configuration (can be NULL)                                      //
+//      output:         result       - pointer to the EdfRecognizeResult structure to fill                          //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, error code of the failed SDK function otherwise                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfRecognize(const EdfAPI* edf_api, const ERImage* image, EdfCropParams* crop_params, void* module_state,
+                 EdfRecognizeResult* result, const EdfRecognizeConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfFreeRecognizeResult                                                                                        //
+//      Frees the classification result and the descriptor of the result created by edfRecognize.                   //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      result       - pointer to the EdfRecognizeResult structure created by edfRecognize          //
+//                      module_state - pointer to the module state                                                  //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void edfFreeRecognizeResult(const EdfAPI* edf_api, EdfRecognizeResult* result, void* module_state);
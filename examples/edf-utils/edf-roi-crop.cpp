@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-roi-crop.h"
+
+#include "edf-alloc.h"
+
+#include <edf_type_mmr.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string.h>
+#include <vector>
+
+// Untuned defaults, see edfRoICropCalibrate
+#define EDF_ROI_DEFAULT_BOX_MARGIN  0.5f
+#define EDF_ROI_DEFAULT_LP_EXTENT_M 3.0f
+
+// Values tried by edfRoICropCalibrate, in increasing order
+static const float EDF_ROI_BOX_MARGINS[]  = {0.05f, 0.1f, 0.15f, 0.2f, 0.3f, 0.4f, 0.5f, 0.75f, 1.0f, 1.5f, 2.0f};
+static const float EDF_ROI_LP_EXTENTS_M[] = {0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 4.0f, 5.0f, 6.0f, 8.0f, 10.0f};
+
+static const double EDF_PI = 3.14159265358979323846;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+           1000.;
+}
+
+static bool isYCbCr(const ERImage* image) {
+    return image->color_model == ER_IMAGE_COLORMODEL_YCBCR420 || image->color_model == ER_IMAGE_COLORMODEL_YCBCRNV12;
+}
+
+int edfCropParamsRoI(const ERImage* image, const EdfCropParams* params, const EdfRoICropConfig* config, ERRoI* roi) {
+    if (!image || !params || !roi) {
+        return -1;
+    }
+    float box_margin  = config && config->box_margin > 0.f ? config->box_margin : EDF_ROI_DEFAULT_BOX_MARGIN;
+    float lp_extent_m = config && config->lp_extent_m > 0.f ? config->lp_extent_m : EDF_ROI_DEFAULT_LP_EXTENT_M;
+
+    double left, top, right, bottom;
+    if (params->points.length == EDF_MMRBOX_CROP_POINTS && params->values.length == EDF_MMRBOX_CROP_VALUES) {
+        left   = std::min(EDF_MMRBOX_TOP_LEFT_X((*params)), EDF_MMRBOX_BOTTOM_RIGHT_X((*params)));
+        right  = std::max(EDF_MMRBOX_TOP_LEFT_X((*params)), EDF_MMRBOX_BOTTOM_RIGHT_X((*params)));
+        top    = std::min(EDF_MMRBOX_TOP_LEFT_Y((*params)), EDF_MMRBOX_BOTTOM_RIGHT_Y((*params)));
+        bottom = std::max(EDF_MMRBOX_TOP_LEFT_Y((*params)), EDF_MMRBOX_BOTTOM_RIGHT_Y((*params)));
+        double margin_x = (right - left) * box_margin;
+        double margin_y = (bottom - top) * box_margin;
+        left -= margin_x;
+        right += margin_x;
+        top -= margin_y;
+        bottom += margin_y;
+    } else if (params->points.length == EDF_MMR_CROP_POINTS && params->values.length == EDF_MMR_CROP_VALUES) {
+        // Bounding box of the rotated square around the LP center.
+        double angle = EDF_LP_ROTATION((*params)) * EDF_PI / 180.0;
+        double half  = lp_extent_m * EDF_LP_SCALE_PX_PER_M((*params)) * (std::fabs(cos(angle)) + std::fabs(sin(angle)));
+        left   = EDF_LP_CENTER_X((*params)) - half;
+        right  = EDF_LP_CENTER_X((*params)) + half;
+        top    = EDF_LP_CENTER_Y((*params)) - half;
+        bottom = EDF_LP_CENTER_Y((*params)) + half;
+    } else {
+        left = top = 0.0;
+        right      = image->width;
+        bottom     = image->height;
+    }
+
+    int x0 = (int)std::max(0.0, std::floor(left));
+    int y0 = (int)std::max(0.0, std::floor(top));
+    int x1 = (int)std::min((double)image->width, std::ceil(right) + 1.0);
+    int y1 = (int)std::min((double)image->height, std::ceil(bottom) + 1.0);
+    if (x0 >= x1 || y0 >= y1) {
+        // The vehicle is out of the image, let edfCropImage handle it.
+        x0 = y0 = 0;
+        x1      = image->width;
+        y1      = image->height;
+    }
+    if (isYCbCr(image)) {
+        // Chroma is subsampled by 2 in both directions.
+        x0 &= ~1;
+        y0 &= ~1;
+        x1 = std::min((int)image->width, (x1 + 1) & ~1);
+        y1 = std::min((int)image->height, (y1 + 1) & ~1);
+    }
+    roi->x      = x0;
+    roi->y      = y0;
+    roi->width  = x1 - x0;
+    roi->height = y1 - y0;
+    return 0;
+}
+
+// Returns the pointer to byte p of the chroma part of the YCbCr image.
+static unsigned char* chromaByte(const ERImage* image, size_t p) {
+    return image->row_data[image->height + p / image->width] + p % image->width;
+}
+
+// Creates the sub-image of the region, the YCBCR420 pixel data are copied to the scratch buffer.
+static int createSubImage(const EdfAPI* edf_api, const ERImage* image, const ERRoI* roi, ERImage* sub,
+                          unsigned char** buffer) {
+    unsigned int x = roi->x, y = roi->y, width = roi->width, height = roi->height;
+    memset(sub, 0, sizeof(ERImage));
+    if (image->color_model == ER_IMAGE_COLORMODEL_YCBCR420) {
+        size_t chroma_size = (size_t)(width / 2) * (height / 2);
+        *buffer = (unsigned char*)edfAllocScratch((size_t)width * height + 2 * chroma_size);
+        if (!*buffer) {
+            return -2;
+        }
+        unsigned char* dst = *buffer;
+        for (unsigned int i = 0; i < height; i++) {
+            memcpy(dst + (size_t)i * width, image->row_data[y + i] + x, width);
+        }
+        // Cb and Cr planes of width / 2 x height / 2 bytes follow the Y plane in the chroma rows.
+        size_t plane_size = (size_t)(image->width / 2) * (image->height / 2);
+        for (unsigned int plane = 0; plane < 2; plane++) {
+            unsigned char* dst_plane = dst + (size_t)width * height + plane * chroma_size;
+            for (unsigned int i = 0; i < height / 2; i++) {
+                size_t src = plane * plane_size + (size_t)(y / 2 + i) * (image->width / 2) + x / 2;
+                memcpy(dst_plane + (size_t)i * (width / 2), chromaByte(image, src), width / 2);
+            }
+        }
+        return edf_api->erImageAllocateAndWrap(sub, width, height, image->color_model, image->data_type, dst, width);
+    }
+
+    unsigned int depth = isYCbCr(image) ? 1 : image->depth;
+    int code = edf_api->erImageAllocateAndWrap(sub, width, height, image->color_model, image->data_type,
+                                               image->row_data[y] + x * depth, image->step);
+    if (code != 0) {
+        return code;
+    }
+    // Point the rows to the input image rows, they are not required to be equidistant.
+    for (unsigned int i = 0; i < height; i++) {
+        sub->row_data[i] = image->row_data[y + i] + x * depth;
+    }
+    if (image->color_model == ER_IMAGE_COLORMODEL_YCBCRNV12) {
+        // One interleaved CbCr row per two Y rows, x is even.
+        for (unsigned int i = 0; i < height / 2; i++) {
+            sub->row_data[height + i] = image->row_data[image->height + y / 2 + i] + x;
+        }
+    }
+    return 0;
+}
+
+int edfCropImageRoI(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                    ERImage* cropped_image, const EdfRoICropConfig* config, EdfRoICropStats* stats) {
+    if (!edf_api || !image_in || !params || !cropped_image) {
+        return -1;
+    }
+    EdfCropImageConfig* crop_config = config ? config->crop_config : NULL;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ERRoI roi;
+    edfCropParamsRoI(image_in, params, config, &roi);
+    if (stats) {
+        stats->roi          = roi;
+        stats->roi_fraction = (float)((double)roi.width * roi.height / ((double)image_in->width * image_in->height));
+    }
+
+    if (roi.x == 0 && roi.y == 0 && roi.width == (int)image_in->width && roi.height == (int)image_in->height) {
+        if (stats) {
+            stats->roi_ms = elapsedMs(start);
+        }
+        start    = std::chrono::steady_clock::now();
+        int code = edf_api->edfCropImage(image_in, params, module_state, cropped_image, crop_config);
+        if (stats) {
+            stats->crop_ms = elapsedMs(start);
+        }
+        return code;
+    }
+
+    ERImage        sub;
+    unsigned char* buffer = NULL;
+    int code = createSubImage(edf_api, image_in, &roi, &sub, &buffer);
+    if (code != 0) {
+        edfFreeScratch(buffer);
+        return code;
+    }
+    std::vector<double> rows(params->points.rows, params->points.rows + params->points.length);
+    std::vector<double> cols(params->points.cols, params->points.cols + params->points.length);
+    for (size_t i = 0; i < rows.size(); i++) {
+        rows[i] -= roi.y;
+        cols[i] -= roi.x;
+    }
+    EdfCropParams shifted = *params;
+    shifted.points.rows   = rows.empty() ? NULL : &rows[0];
+    shifted.points.cols   = cols.empty() ? NULL : &cols[0];
+    if (stats) {
+        stats->roi_ms = elapsedMs(start);
+    }
+
+    start = std::chrono::steady_clock::now();
+    code  = edf_api->edfCropImage(&sub, &shifted, module_state, cropped_image, crop_config);
+    if (stats) {
+        stats->crop_ms = elapsedMs(start);
+    }
+    edf_api->erImageFree(&sub);
+    edfFreeScratch(buffer);
+    return code;
+}
+
+// Compares the pixel data of two crops row by row, the row padding is ignored.
+static bool sameCrop(const ERImage* a, const ERImage* b) {
+    if (a->width != b->width || a->height != b->height || a->color_model != b->color_model ||
+        a->data_type != b->data_type || a->depth != b->depth) {
+        return false;
+    }
+    bool         ycbcr     = isYCbCr(a);
+    unsigned int num_rows  = ycbcr ? a->height * 3 / 2 : a->height;
+    size_t       row_bytes = ycbcr ? a->width : (size_t)a->width * a->depth;
+    for (unsigned int i = 0; i < num_rows; i++) {
+        if (memcmp(a->row_data[i], b->row_data[i], row_bytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int edfRoICropCalibrate(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                        EdfRoICropConfig* config) {
+    if (!edf_api || !image_in || !params || !config) {
+        return -1;
+    }
+    bool box = params->points.length == EDF_MMRBOX_CROP_POINTS && params->values.length == EDF_MMRBOX_CROP_VALUES;
+    bool lp  = params->points.length == EDF_MMR_CROP_POINTS && params->values.length == EDF_MMR_CROP_VALUES;
+    if (!box && !lp) {
+        return -1;
+    }
+    const float* values     = box ? EDF_ROI_BOX_MARGINS : EDF_ROI_LP_EXTENTS_M;
+    size_t       num_values = box ? sizeof(EDF_ROI_BOX_MARGINS) / sizeof(float)
+                                  : sizeof(EDF_ROI_LP_EXTENTS_M) / sizeof(float);
+    ERImage reference;
+    memset(&reference, 0, sizeof(ERImage));
+    int code = edf_api->edfCropImage(image_in, params, module_state, &reference, config->crop_config);
+    if (code != 0) {
+        return code;
+    }
+    // The smallest value giving the same crop as the whole image.
+    EdfRoICropConfig trial = *config;
+    float            found = 0.f;
+    for (size_t v = 0; v < num_values && found == 0.f && code == 0; v++) {
+        trial.box_margin  = box ? values[v] : config->box_margin;
+        trial.lp_extent_m = lp ? values[v] : config->lp_extent_m;
+        ERImage crop;
+        memset(&crop, 0, sizeof(ERImage));
+        code = edfCropImageRoI(edf_api, image_in, params, module_state, &crop, &trial, NULL);
+        if (code == 0) {
+            if (sameCrop(&reference, &crop)) {
+                found = values[v];
+            }
+            edf_api->edfFreeCropImage(module_state, &crop);
+        }
+    }
+    edf_api->edfFreeCropImage(module_state, &reference);
+    if (code != 0) {
+        return code;
+    }
+    if (found == 0.f) {
+        return -3;
+    }
+    float& value = box ? config->box_margin : config->lp_extent_m;
+    value        = std::max(value, found);
+    return 0;
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfRoICropConfig                                    //
+//////////////////////////////////////////////////////////////
+// EdfRoICropConfig represents the configuration            //
+// parameters of the region of interest restricted crop.    //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    EdfCropImageConfig* crop_config;     // image cropping configuration (can be NULL)
+    float box_margin;                    // MMRBOX: margin added to each side of the box, relative to the box size
+                                         // Set to 0.0f to use the default value 0.5f. DEFAULT
+                                         // The default is not derived from the crop of the module, tune it by
+                                         // edfRoICropCalibrate.
+    float lp_extent_m;                   // LP: half-size of the region around the LP center in meters
+                                         // Set to 0.0f to use the default value 3.0f. DEFAULT
+                                         // The default is not derived from the crop of the module, tune it by
+                                         // edfRoICropCalibrate.
+} EdfRoICropConfig;
+
+//////////////////////////////////////////////////////////////
+//      EdfRoICropStats                                     //
+//////////////////////////////////////////////////////////////
+// EdfRoICropStats contains the region of interest and the  //
+// per-stage times of one edfCropImageRoI call.             //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    ERRoI  roi;                          // region of the input image passed to edfCropImage
+    float  roi_fraction;                 // ratio of the region area to the input image area
+    double roi_ms;                       // region computation and sub-image creation
+    double crop_ms;                      // edfCropImage on the sub-image (color conversion and alignment)
+} EdfRoICropStats;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCropParamsRoI                                                                                              //
+//      Computes the region of the input image read by the crop of a vehicle given by the LP or MMRBOX crop         //
+//      parameters (see edf_type_mmr.h), clipped to the image. For YCbCr color models the region is aligned to      //
+//      even coordinates. The region covers the whole image for other crop parameters.                              //
+//                                                                                                                  //
+//      input:          image  - pointer to the input image                                                         //
+//                      params - crop parameters                                                                    //
+//                      config - region configuration (can be NULL)                                                 //
+//      output:         roi    - pointer to the region to fill                                                      //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCropParamsRoI(const ERImage* image, const EdfCropParams* params, const EdfRoICropConfig* config, ERRoI* roi);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCropImageRoI                                                                                               //
+//      Crops the vehicle from the region of the input image given by edfCropParamsRoI only, so that the color      //
+//      conversion of BGRA and YCbCr inputs done by edfCropImage is restricted to the region. GRAY, BGR, BGRA and   //
+//      YCBCRNV12 regions are wrapped without copying, YCBCR420 regions are copied as their chroma rows cannot be   //
+//      addressed in place. Pixels outside the region are treated as outside of the image, keep the margins large   //
+//      enough for the used crop, see edfRoICropCalibrate. The YCBCR420 copy is allocated by edfAllocScratch (see   //
+//      edf-alloc.h). The YCBCR420 and YCBCRNV12 regions rely on the library reading the chroma rows through        //
+//      row_data[height..] as described in edf-planes.h: the input chroma is read and the NV12 region is wrapped    //
+//      that way.                                                                                                   //
+//      See edfCropImage for the description of the other arguments and the return values, -2 is returned if the    //
+//      YCBCR420 copy cannot be allocated.                                                                          //
+//                                                                                                                  //
+//      input:          edf_api - pointer to the linked Eyedentify API                                              //
+//                      config  - region restricted crop configuration (can be NULL)                                //
+//      output:         stats   - pointer to the EdfRoICropStats structure to fill (can be NULL)                    //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCropImageRoI(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                    ERImage* cropped_image, const EdfRoICropConfig* config, EdfRoICropStats* stats);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfRoICropCalibrate                                                                                           //
+//      Derives the region size for the module: crops the vehicle from the whole image and from regions of growing  //
+//      box_margin (MMRBOX parameters) or lp_extent_m (LP parameters) and sets the field to the smallest value      //
+//      giving the same crop, if larger than the current value. Call it once per module and crop configuration      //
+//      with several vehicles lying fully inside the image, the field keeps the maximum over the calls, then use    //
+//      the configuration for edfCropImageRoI. A margin for the detection jitter can be added on top.               //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      image_in     - pointer to the input image                                                   //
+//                      params       - LP or MMRBOX crop parameters of a vehicle                                    //
+//                      module_state - pointer to the module state                                                  //
+//      input/output:   config       - region restricted crop configuration to update                               //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments or other crop parameters,                             //
+//                      -3 if no tried value gives the same crop, edfCropImage error code otherwise                 //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfRoICropCalibrate(const EdfAPI* edf_api, const ERImage* image_in, EdfCropParams* params, void* module_state,
+                        EdfRoICropConfig* config);
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-search.h"
+
+#include "edf-context.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Minimal number of descriptors compared by one thread, smaller chunks are not worth the thread start.
+#define EDF_SEARCH_MIN_CHUNK 1024
+
+static unsigned int resolveNumThreads(const EdfSearchConfig* config, unsigned int count) {
+    // The SDK is not thread-safe, concurrent edfCompareDescs calls need the explicit opt-in of the shared state.
+    if (!config || !edfSharedStateConcurrent(config->shared_state)) {
+        return 1;
+    }
+    int num_threads = config->num_threads;
+    unsigned int hw_threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int threads;
+    if (num_threads == 0) {
+        threads = 1;
+    } else if (num_threads < 0) {
+        threads = std::max(1u, (unsigned int)(0.9 * hw_threads));
+    } else {
+        threads = std::min((unsigned int)num_threads, hw_threads);
+    }
+    // Do not start threads with nothing to do.
+    unsigned int max_threads = std::max(1u, count / EDF_SEARCH_MIN_CHUNK);
+    return std::min(threads, max_threads);
+}
+
+static int checkGallery(const EdfAPI* edf_api, const EdfDescriptor* query, const EdfDescriptorGallery* gallery,
+                        const void* module_state, const EdfSearchConfig* config) {
+    if (!edf_api || !edf_api->edfCompareDescs || !query || !query->data || !gallery || !module_state) {
+        return -1;
+    }
+    if (config && config->shared_state && edfSharedStateModuleState(config->shared_state) != module_state) {
+        return -1;
+    }
+    if (gallery->count > 0 && !gallery->data) {
+        return -1;
+    }
+    if (gallery->desc_size > gallery->stride) {
+        return -1;
+    }
+    if (query->version != gallery->version || query->size != gallery->desc_size) {
+        return -2;
+    }
+    return 0;
+}
+
+// Calls edfCompareDescs of one thread over its chunk. When the module state is shared, the thread holds it through
+// its own context for the whole chunk, not per row.
+class SearchComparer {
+public:
+    SearchComparer(const EdfAPI* edf_api, const void* module_state, const EdfSearchConfig* config)
+        : edf_api_(edf_api), module_state_(module_state), context_(NULL), code_(0) {
+        if (config && config->shared_state) {
+            code_ = edfCreateContext(config->shared_state, &context_);
+            if (code_ == 0) {
+                code_ = edfContextAcquireConst(context_, &module_state_);
+            }
+        }
+    }
+
+    ~SearchComparer() {
+        if (context_ && code_ == 0) {
+            edfContextReleaseConst(context_);
+        }
+        edfFreeContext(&context_);
+    }
+
+    int compare(const EdfDescriptor* query, const EdfDescriptor* row, float* score) {
+        if (code_ != 0) {
+            return code_;
+        }
+        return edf_api_->edfCompareDescs(query, row, module_state_, score);
+    }
+
+private:
+    const EdfAPI* edf_api_;
+    const void*   module_state_;
+    void*         context_;
+    int           code_;
+};
+
+// Orders search results by descending score, equal scores by ascending gallery index.
+static bool betterResult(const EdfSearchResult& a, const EdfSearchResult& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+// Runs fcn(thread_id, begin, end) on num_threads disjoint ranges of [0, count) and returns the first error.
+template <typename Fcn>
+static int runChunks(unsigned int count, unsigned int num_threads, Fcn fcn) {
+    if (num_threads <= 1) {
+        return fcn(0, 0, count);
+    }
+    std::vector<int> codes(num_threads, 0);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    unsigned int chunk = (count + num_threads - 1) / num_threads;
+    for (unsigned int t = 1; t < num_threads; t++) {
+        unsigned int begin = std::min(count, t * chunk);
+        unsigned int end   = std::min(count, begin + chunk);
+        threads.emplace_back([&codes, &fcn, t, begin, end]() { codes[t] = fcn(t, begin, end); });
+    }
+    // The calling thread processes the first chunk.
+    codes[0] = fcn(0, 0, std::min(count, chunk));
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    for (unsigned int t = 0; t < num_threads; t++) {
+        if (codes[t] != 0) {
+            return codes[t];
+        }
+    }
+    return 0;
+}
+
+unsigned int edfGalleryStride(unsigned int desc_size) {
+    return (desc_size + EDF_MEMORY_ALIGNMENT - 1) / EDF_MEMORY_ALIGNMENT * EDF_MEMORY_ALIGNMENT;
+}
+
+int edfCompareDescsBatch(const EdfAPI* edf_api, const EdfDescriptor* query, const EdfDescriptorGallery* gallery,
+                         const void* module_state, float* scores, const EdfSearchConfig* config) {
+    int check_code = checkGallery(edf_api, query, gallery, module_state, config);
+    if (check_code != 0) {
+        return check_code;
+    }
+    if (gallery->count > 0 && !scores) {
+        return -1;
+    }
+    unsigned int num_threads = resolveNumThreads(config, gallery->count);
+    return runChunks(gallery->count, num_threads, [&](unsigned int, unsigned int begin, unsigned int end) {
+        // The gallery rows are wrapped, no descriptor data is copied.
+        SearchComparer comparer(edf_api, module_state, config);
+        EdfDescriptor  row;
+        row.version = gallery->version;
+        row.size    = gallery->desc_size;
+        for (unsigned int i = begin; i < end; i++) {
+            row.data = gallery->data + (size_t)i * gallery->stride;
+            int code = comparer.compare(query, &row, &scores[i]);
+            if (code != 0) {
+                return code;
+            }
+        }
+        return 0;
+    });
+}
+
+int edfSearchDescs(const EdfAPI* edf_api, const EdfDescriptor* query, const EdfDescriptorGallery* gallery,
+                   const void* module_state, unsigned int top_k, EdfSearchResult* results, unsigned int* num_results,
+                   const EdfSearchConfig* config) {
+    int check_code = checkGallery(edf_api, query, gallery, module_state, config);
+    if (check_code != 0) {
+        return check_code;
+    }
+    if (!num_results || (top_k > 0 && !results)) {
+        return -1;
+    }
+    *num_results = 0;
+    unsigned int k = std::min(top_k, gallery->count);
+    if (k == 0) {
+        return 0;
+    }
+    unsigned int num_threads = resolveNumThreads(config, gallery->count);
+    // Each thread keeps a heap of its k best candidates, the worst one on the top.
+    std::vector<std::vector<EdfSearchResult> > heaps(num_threads);
+    int code = runChunks(gallery->count, num_threads, [&](unsigned int t, unsigned int begin, unsigned int end) {
+        std::vector<EdfSearchResult>& heap = heaps[t];
+        heap.reserve(k);
+        SearchComparer comparer(edf_api, module_state, config);
+        EdfDescriptor  row;
+        row.version = gallery->version;
+        row.size    = gallery->desc_size;
+        for (unsigned int i = begin; i < end; i++) {
+            EdfSearchResult candidate;
+            candidate.index = i;
+            row.data = gallery->data + (size_t)i * gallery->stride;
+            int compare_code = comparer.compare(query, &row, &candidate.score);
+            if (compare_code != 0) {
+                return compare_code;
+            }
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end(), betterResult);
+            } else if (betterResult(candidate, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), betterResult);
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end(), betterResult);
+            }
+        }
+        return 0;
+    });
+    if (code != 0) {
+        return code;
+    }
+    // Merge the candidates of all threads.
+    std::vector<EdfSearchResult> merged;
+    merged.reserve((size_t)k * num_threads);
+    for (unsigned int t = 0; t < num_threads; t++) {
+        merged.insert(merged.end(), heaps[t].begin(), heaps[t].end());
+    }
+    std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), betterResult);
+    std::copy(merged.begin(), merged.begin() + k, results);
+    *num_results = k;
+    return 0;
+}
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+//////////////////////////////////////////////////////////////
+//      EdfDescriptorGallery                                //
+//////////////////////////////////////////////////////////////
+// EdfDescriptorGallery is a contiguous array of            //
+// descriptors of the same version and size. The rows are   //
+// stride bytes apart; keep data and stride aligned to      //
+// EDF_MEMORY_ALIGNMENT to benefit from the SIMD matching   //
+// inside edfCompareDescs.                                  //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int   version;     // version of the model used to create all descriptors
+    unsigned int   desc_size;   // number of bytes of one descriptor
+    unsigned int   stride;      // number of bytes between two consecutive descriptors (desc_size <= stride)
+    unsigned int   count;       // number of descriptors in the gallery
+    unsigned char* data;        // pointer to the first descriptor data
+} EdfDescriptorGallery;
+
+//////////////////////////////////////////////////////////////
+//      EdfSearchResult                                     //
+//////////////////////////////////////////////////////////////
+// EdfSearchResult is one entry of the edfSearchDescs       //
+// result, the index of the gallery descriptor and its      //
+// score to the query descriptor.                           //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    unsigned int index;         // index of the descriptor in the gallery
+    float        score;         // edfCompareDescs score of the query and the gallery descriptor
+} EdfSearchResult;
+
+//////////////////////////////////////////////////////////////
+//      EdfSearchConfig                                     //
+//////////////////////////////////////////////////////////////
+// EdfSearchConfig represents the configuration parameters  //
+// used during the 1:N descriptor search.                   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    int   num_threads;          // number of threads to split the gallery between; special values: 0 for 1 thread, <0 for 0.9*std::thread::hardware_concurency
+                                // Use the same value as EdfInitConfig.num_threads of the module state to keep the CPU usage bounded.
+                                // The SDK is not thread-safe, more than 1 thread is used only with a shared_state
+                                // having concurrent_const_calls enabled.
+    void* shared_state;         // shared state of the module state (edf-context.h) to call edfCompareDescs through,
+                                // NULL to call it directly on the module state. DEFAULT
+} EdfSearchConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfGalleryStride                                                                                              //
+//      Returns the row stride of the gallery for the given descriptor size. The stride is the descriptor size      //
+//      rounded up to the multiple of EDF_MEMORY_ALIGNMENT, so every row of an aligned gallery stays aligned.       //
+//                                                                                                                  //
+//      input:          desc_size - number of bytes of one descriptor                                               //
+//                                                                                                                  //
+//      return value:   row stride in bytes                                                                         //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int edfGalleryStride(unsigned int desc_size);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfCompareDescsBatch                                                                                          //
+//      Compares the query descriptor with all descriptors of the gallery and fills the array of scores.            //
+//      The version and size of the descriptors is checked only once for the whole gallery. The gallery is split    //
+//      between config->num_threads threads only if config->shared_state allows concurrent const calls (the SDK     //
+//      is not thread-safe otherwise). Each thread then holds the shared state through its own context once for     //
+//      its whole chunk of rows (edfContextAcquireConst), writers of the shared state wait until the scan ends.     //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      query        - query descriptor, outputted by edfComputeDesc                                //
+//                      gallery      - gallery of descriptors of the same version as query                          //
+//                      module_state - pointer to the module state, wrapped by config->shared_state if set          //
+//                      config       - search configuration (can be NULL, single thread is used)                    //
+//      output:         scores       - user allocated array of gallery->count scores to be filled                   //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, edfCompareDescs error code otherwise     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfCompareDescsBatch(const EdfAPI* edf_api, const EdfDescriptor* query, const EdfDescriptorGallery* gallery,
+                         const void* module_state, float* scores, const EdfSearchConfig* config);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfSearchDescs                                                                                                //
+//      Searches the gallery for the top_k descriptors with the highest score to the query descriptor. Each thread  //
+//      keeps its own top_k candidates only, so no array of gallery->count scores is needed. Threads are used under //
+//      the same conditions as in edfCompareDescsBatch.                                                             //
+//                                                                                                                  //
+//      input:          edf_api      - pointer to the linked Eyedentify API                                         //
+//                      query        - query descriptor, outputted by edfComputeDesc                                //
+//                      gallery      - gallery of descriptors of the same version as query                          //
+//                      module_state - pointer to the module state, wrapped by config->shared_state if set          //
+//                      top_k        - maximal number of results to return                                          //
+//                      config       - search configuration (can be NULL, single thread is used)                    //
+//      output:         results      - user allocated array of top_k results, sorted by descending score            //
+//                      num_results  - number of filled results, min(top_k, gallery->count)                         //
+//                                                                                                                  //
+//      return value:   0 on success, error code on failure                                                         //
+//                      -1 invalid arguments, -2 version or size mismatch, edfCompareDescs error code otherwise     //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfSearchDescs(const EdfAPI* edf_api, const EdfDescriptor* query, const EdfDescriptorGallery* gallery,
+                   const void* module_state, unsigned int top_k, EdfSearchResult* results, unsigned int* num_results,
+                   const EdfSearchConfig* config);
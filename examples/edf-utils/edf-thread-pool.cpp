@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+
+#include "edf-thread-pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+struct EdfThreadPool;
+
+struct PoolTask {
+    fcn_edfPoolTask    task;
+    void*              user_data;
+    unsigned long long sequence;         // submission order for the oldest first selection
+};
+
+struct EdfPoolLane {
+    EdfThreadPool*          pool;
+    int                     priority;
+    unsigned int            max_concurrency;
+    unsigned int            running;
+    bool                    removing;
+    std::deque<PoolTask>    tasks;
+    std::condition_variable idle_cond;   // signals waiters that the lane has no queued or running task
+};
+
+struct EdfThreadPool {
+    std::mutex                mutex;
+    std::condition_variable   task_cond; // signals the workers about new runnable tasks or stop
+    std::vector<EdfPoolLane*> lanes;
+    std::vector<std::thread>  workers;
+    unsigned long long        sequence;
+    bool                      stopping;
+
+    // Returns the lane to take the next task from, NULL if no task can run.
+    EdfPoolLane* nextLane() const {
+        EdfPoolLane* best = NULL;
+        for (size_t i = 0; i < lanes.size(); i++) {
+            EdfPoolLane* lane = lanes[i];
+            if (lane->tasks.empty() || lane->running >= lane->max_concurrency) {
+                continue;
+            }
+            if (!best || lane->priority > best->priority ||
+                (lane->priority == best->priority && lane->tasks.front().sequence < best->tasks.front().sequence)) {
+                best = lane;
+            }
+        }
+        return best;
+    }
+
+    bool hasTasks() const {
+        for (size_t i = 0; i < lanes.size(); i++) {
+            if (!lanes[i]->tasks.empty() || lanes[i]->running > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            EdfPoolLane* lane = NULL;
+            task_cond.wait(lock, [this, &lane]() {
+                lane = nextLane();
+                return lane || (stopping && !hasTasks());
+            });
+            if (!lane) {
+                return;
+            }
+            PoolTask task = lane->tasks.front();
+            lane->tasks.pop_front();
+            lane->running++;
+            lock.unlock();
+
+            task.task(task.user_data);
+
+            lock.lock();
+            lane->running--;
+            if (lane->tasks.empty() && lane->running == 0) {
+                lane->idle_cond.notify_all();
+            }
+            // The lane may accept another task now, stopping workers wait for all lanes to be idle.
+            task_cond.notify_all();
+        }
+    }
+};
+
+static void pinThread(std::thread& thread, unsigned int cpu) {
+#if _WIN32 || _WIN64
+    SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << (cpu % (8 * sizeof(DWORD_PTR))));
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+static unsigned int hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+int edfThreadPoolCreate(const EdfThreadPoolConfig* config, void** pool) {
+    if (!pool) {
+        return -1;
+    }
+    unsigned int num_cpus    = hardwareThreads();
+    unsigned int num_threads = config && config->num_threads > 0 ? (unsigned int)config->num_threads : num_cpus;
+    EdfThreadPool* state = new EdfThreadPool();
+    state->sequence      = 0;
+    state->stopping      = false;
+    for (unsigned int i = 0; i < num_threads; i++) {
+        state->workers.push_back(std::thread(&EdfThreadPool::run, state));
+        if (config && config->pin_threads == EDF_CONFIG_VALUE_ENABLED) {
+            pinThread(state->workers.back(), (unsigned int)(std::max(0, config->first_cpu) + i) % num_cpus);
+        }
+    }
+    *pool = state;
+    return 0;
+}
+
+int edfThreadPoolFree(void** pool) {
+    if (!pool || !*pool) {
+        return -1;
+    }
+    EdfThreadPool* state = (EdfThreadPool*)*pool;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->lanes.empty()) {
+            // The lanes are owned by their users (e.g. edfAsyncFree removes its lane), they would be left dangling.
+            return -2;
+        }
+        state->stopping = true;
+    }
+    state->task_cond.notify_all();
+    for (size_t i = 0; i < state->workers.size(); i++) {
+        state->workers[i].join();
+    }
+    delete state;
+    *pool = NULL;
+    return 0;
+}
+
+unsigned int edfThreadPoolNumThreads(const void* pool) {
+    return pool ? (unsigned int)((const EdfThreadPool*)pool)->workers.size() : 0;
+}
+
+int edfThreadPoolInitThreads(const void* pool) {
+    unsigned int num_threads = edfThreadPoolNumThreads(pool);
+    return num_threads ? (int)std::max(1u, hardwareThreads() / num_threads) : 0;
+}
+
+int edfThreadPoolAddLane(void* pool, int priority, unsigned int max_concurrency, void** lane) {
+    if (!pool || !lane) {
+        return -1;
+    }
+    EdfThreadPool* state = (EdfThreadPool*)pool;
+    EdfPoolLane*   added = new EdfPoolLane();
+    added->pool            = state;
+    added->priority        = priority;
+    added->max_concurrency = std::max(1u, max_concurrency);
+    added->running         = 0;
+    added->removing        = false;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->lanes.push_back(added);
+    *lane = added;
+    return 0;
+}
+
+void edfThreadPoolRemoveLane(void** lane) {
+    if (!lane || !*lane) {
+        return;
+    }
+    EdfPoolLane*   removed = (EdfPoolLane*)*lane;
+    EdfThreadPool* state   = removed->pool;
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        removed->removing = true;
+        removed->idle_cond.wait(lock, [removed]() { return removed->tasks.empty() && removed->running == 0; });
+        state->lanes.erase(std::find(state->lanes.begin(), state->lanes.end(), removed));
+    }
+    delete removed;
+    *lane = NULL;
+}
+
+int edfThreadPoolSetPriority(void* lane, int priority) {
+    if (!lane) {
+        return -1;
+    }
+    EdfPoolLane*                state = (EdfPoolLane*)lane;
+    std::lock_guard<std::mutex> lock(state->pool->mutex);
+    state->priority = priority;
+    return 0;
+}
+
+int edfThreadPoolSubmit(void* lane, fcn_edfPoolTask task, void* user_data) {
+    if (!lane || !task) {
+        return -1;
+    }
+    EdfPoolLane*   state = (EdfPoolLane*)lane;
+    EdfThreadPool* pool  = state->pool;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (state->removing) {
+            return -2;
+        }
+        PoolTask queued;
+        queued.task      = task;
+        queued.user_data = user_data;
+        queued.sequence  = pool->sequence++;
+        state->tasks.push_back(queued);
+    }
+    pool->task_cond.notify_one();
+    return 0;
+}
+
+int edfThreadPoolWait(void* lane) {
+    if (!lane) {
+        return -1;
+    }
+    EdfPoolLane*                 state = (EdfPoolLane*)lane;
+    std::unique_lock<std::mutex> lock(state->pool->mutex);
+    state->idle_cond.wait(lock, [state]() { return state->tasks.empty() && state->running == 0; });
+    return 0;
+}
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////
+//                   EYEDENTIFY SDK                      //
+//                 recognition library                   //
+///////////////////////////////////////////////////////////
+#include <edf.h>
+
+// Task run by the pool.
+typedef void (*fcn_edfPoolTask)(void* user_data);
+
+//////////////////////////////////////////////////////////////
+//      EdfThreadPoolConfig                                 //
+//////////////////////////////////////////////////////////////
+// EdfThreadPoolConfig represents the configuration         //
+// parameters of the thread pool shared by module states.   //
+//////////////////////////////////////////////////////////////
+typedef struct {
+    int num_threads;               // Number of worker threads.
+                                   // Set 0 or less to use the number of hardware threads. DEFAULT
+    int pin_threads;               // Set to  1 to pin worker i to the CPU (first_cpu + i) modulo the number of CPUs.
+                                   // Set to  0 or -1 to let the OS schedule the workers. DEFAULT
+    int first_cpu;                 // first CPU of the pinned workers
+} EdfThreadPoolConfig;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolCreate, edfThreadPoolFree                                                                        //
+//      Creates the pool and starts its worker threads / stops the workers and frees the pool. Create one pool per  //
+//      process and attach all module states to it. All lanes must be removed before the pool is freed (e.g. all    //
+//      edf-async engines freed by edfAsyncFree), the pool is not freed while a lane is attached.                   //
+//                                                                                                                  //
+//      input:          config - pool configuration (can be NULL)                                                   //
+//      output:         pool   - pointer to the pool                                                                //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments,                                                      //
+//                      edfThreadPoolFree: -2 if a lane is still attached, the pool is left running                 //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfThreadPoolCreate(const EdfThreadPoolConfig* config, void** pool);
+int edfThreadPoolFree(void** pool);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolNumThreads, edfThreadPoolInitThreads                                                             //
+//      Returns the number of worker threads of the pool / the EdfInitConfig.num_threads to initialize the module   //
+//      states attached to the pool with, so that the workers running inference at once use at most all hardware    //
+//      threads instead of each module state using 0.9 of them.                                                     //
+//                                                                                                                  //
+//      return value:   number of threads, 0 on invalid arguments                                                   //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int edfThreadPoolNumThreads(const void* pool);
+int          edfThreadPoolInitThreads(const void* pool);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolAddLane, edfThreadPoolRemoveLane                                                                 //
+//      Attaches a module state to the pool as a lane / waits for the tasks of the lane and detaches it. Tasks of   //
+//      one lane run at most max_concurrency at once (1 for a module state, which must not be used by several       //
+//      threads at once). Free workers take the oldest task of the lane with the highest priority.                  //
+//                                                                                                                  //
+//      input:          pool            - pointer to the pool                                                       //
+//                      priority        - priority of the lane, higher runs first                                   //
+//                      max_concurrency - maximal number of tasks of the lane running at once, 0 means 1            //
+//      output:         lane            - pointer to the lane                                                       //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int  edfThreadPoolAddLane(void* pool, int priority, unsigned int max_concurrency, void** lane);
+void edfThreadPoolRemoveLane(void** lane);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolSetPriority                                                                                      //
+//      Changes the priority of the lane, the tasks already queued are taken in the new order.                      //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfThreadPoolSetPriority(void* lane, int priority);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolSubmit                                                                                           //
+//      Queues the task to the lane and returns immediately. The function is thread-safe.                           //
+//                                                                                                                  //
+//      input:          lane      - pointer to the lane                                                             //
+//                      task      - task function                                                                   //
+//                      user_data - user data passed to the task                                                    //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments, -2 if the lane is being removed                      //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfThreadPoolSubmit(void* lane, fcn_edfPoolTask task, void* user_data);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    edfThreadPoolWait                                                                                             //
+//      Waits until all tasks submitted to the lane are finished. Do not call it from a task of the pool.           //
+//                                                                                                                  //
+//      return value:   0 on success, -1 on invalid arguments                                                       //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int edfThreadPoolWait(void* lane);
@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2024 by Eyedea Recognition, s.r.o.      //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                   EYEDEA MMR SDK                      //
+//          image cropping microbenchmark example        //
+///////////////////////////////////////////////////////////
+
+// Eyedea MMR include - include path to sdk/include must be added
+#include <edf.h>
+#include <edf_type_mmr.h>
+// Eyedentify utilities - include path to examples/edf-utils must be added
+#include <edf-pyramid.h>
+
+#include <chrono>  // time measure
+#include <cstring>
+#include <iostream>
+#include <string>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// CONSTANTS - SDK PATH, MODULE NAME, MODEL, INPUT                            //
+////////////////////////////////////////////////////////////////////////////////
+const char *EDF_SDK_PATH    = "../../sdk/";
+const char *EDF_MODULE_NAME = "edftf2lite"; // module name depends on the type and version, do not change
+const char *MMRBOX_MODEL    = "MMRBOX_VCMMCT_FAST_2024Q2.dat";
+
+const char *DEFAULT_IMAGE      = "../../data/images-mmr/car_cz.jpg";
+const float DEFAULT_CARBOX[4]  = {282.0f, 142.0f, 754.0f, 640.0f}; // top left x, y, bottom right x, y
+const int   DEFAULT_ITERATIONS = 100;
+const int   DEFAULT_UPSCALE    = 4;     // the image is upscaled to simulate 4K camera frames
+
+const char *SIMD_LEVEL_NAMES[] = {"scalar", "SSE2", "AVX2", "NEON"};
+
+////////////////////////////////////////////////////////////////////////////////
+// HELPER FUNCTIONS                                                           //
+////////////////////////////////////////////////////////////////////////////////
+bool check_arg(const char *arg, std::string option, std::string &retv);
+int parse_arguments(int argc, char * argv[], bool &help, std::string &image_file, int &iterations, int &upscale);
+ERImage upscaleImage(EdfAPI &api, const ERImage &image, int factor); //< nearest neighbour upscale of an UCHAR image
+
+typedef std::chrono::steady_clock::time_point time_point;
+double elapsedMs(time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Image cropping microbenchmark                                                     //
+///////////////////////////////////////////////////////////////////////////////////////
+//   Compares the average time of one vehicle crop from a large frame:               //
+//       1) edfCropImage with antialiasing,                                          //
+//       2) edfCropImage without antialiasing,                                       //
+//       3) edfBuildImagePyramid + edfCropImagePyramid without antialiasing,         //
+//   and the pyramid build time for every downscaling kernel supported by the CPU.   //
+///////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char * argv[]) {
+    std::string option_image = DEFAULT_IMAGE;
+    int option_iterations = DEFAULT_ITERATIONS;
+    int option_upscale = DEFAULT_UPSCALE;
+    bool help = false;
+    if (parse_arguments(argc, argv, help, option_image, option_iterations, option_upscale) != 0) {
+        std::cerr << "Argument parsing failed!\n";
+        return -1;
+    }
+    if (help) return 0;
+
+    EdfAPI edfAPI;
+    edfLinkAPI(nullptr, &edfAPI);
+
+    std::string edfModulePath = std::string(EDF_SDK_PATH) + "modules/" + std::string(EDF_MODULE_NAME) + "/";
+    EdfInitConfig config{};
+    config.module_path      = edfModulePath.c_str();
+    config.model_file       = MMRBOX_MODEL;
+    config.computation_mode = ER_COMPUTATION_MODE_CPU;
+    config.num_threads      = 1;
+    config.onnx_provider    = "cpu";
+    void *mmr_state = nullptr;
+    if (edfAPI.edfInitEyedentify(&config, &mmr_state) != 0) {
+        std::cerr << "Error during Eyedentify module initialization!\n";
+        return -1;
+    }
+
+    ERImage original;
+    std::memset(&original, 0, sizeof(ERImage));
+    if (edfAPI.erImageRead(&original, option_image.c_str()) != 0) {
+        std::cerr << "Error during " << option_image << " image reading!\n";
+        edfAPI.edfFreeEyedentify(&mmr_state);
+        return -1;
+    }
+    ERImage image = upscaleImage(edfAPI, original, option_upscale);
+    edfAPI.erImageFree(&original);
+    std::cout << "Frame: " << image.width << "x" << image.height << ", " << option_iterations << " iterations"
+              << std::endl;
+
+    EdfCropParams params;
+    edfAPI.edfCropParamsAllocate(EDF_MMRBOX_CROP_POINTS, EDF_MMRBOX_CROP_VALUES, &params);
+    EDF_MMRBOX_TOP_LEFT_X(params)     = DEFAULT_CARBOX[0] * option_upscale;
+    EDF_MMRBOX_TOP_LEFT_Y(params)     = DEFAULT_CARBOX[1] * option_upscale;
+    EDF_MMRBOX_BOTTOM_RIGHT_X(params) = DEFAULT_CARBOX[2] * option_upscale;
+    EDF_MMRBOX_BOTTOM_RIGHT_Y(params) = DEFAULT_CARBOX[3] * option_upscale;
+
+    EdfCropImageConfig crop_config_aa{};
+    crop_config_aa.use_antialiasing = EDF_CONFIG_VALUE_ENABLED;
+    EdfCropImageConfig crop_config_no_aa{};
+    crop_config_no_aa.use_antialiasing = EDF_CONFIG_VALUE_DISABLED;
+
+    //////////////////////////////////////////////////////////////
+    // 1), 2) edfCropImage with and without antialiasing
+    //////////////////////////////////////////////////////////////
+    EdfCropImageConfig *crop_configs[] = {&crop_config_aa, &crop_config_no_aa};
+    const char *crop_names[] = {"edfCropImage, antialiasing:          ", "edfCropImage, no antialiasing:       "};
+    for (int c = 0; c < 2; c++) {
+        time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < option_iterations; i++) {
+            ERImage crop;
+            if (edfAPI.edfCropImage(&image, &params, mmr_state, &crop, crop_configs[c]) != 0) {
+                std::cerr << "Error during image cropping!\n";
+                break;
+            }
+            edfAPI.edfFreeCropImage(mmr_state, &crop);
+        }
+        std::cout << crop_names[c] << elapsedMs(start) / option_iterations << " ms" << std::endl;
+    }
+
+    //////////////////////////////////////////////////////////////
+    // 3) Pyramid + crop from the pyramid level
+    //////////////////////////////////////////////////////////////
+    EdfPyramidConfig pyramid_config{};
+    pyramid_config.num_levels = EDF_PYRAMID_MAX_LEVELS;
+    EdfImagePyramid pyramid;
+    std::memset(&pyramid, 0, sizeof(EdfImagePyramid));
+    edfBuildImagePyramid(&edfAPI, &image, &pyramid_config, &pyramid);
+    // The first crop learns the crop size of the module.
+    ERImage crop;
+    if (edfCropImagePyramid(&edfAPI, &pyramid, &params, mmr_state, &crop, &crop_config_no_aa) == 0) {
+        edfAPI.edfFreeCropImage(mmr_state, &crop);
+    }
+    double build_ms = 0.0, crop_ms = 0.0;
+    for (int i = 0; i < option_iterations; i++) {
+        time_point start = std::chrono::steady_clock::now();
+        edfBuildImagePyramid(&edfAPI, &image, &pyramid_config, &pyramid);
+        build_ms += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        if (edfCropImagePyramid(&edfAPI, &pyramid, &params, mmr_state, &crop, &crop_config_no_aa) != 0) {
+            std::cerr << "Error during image cropping!\n";
+            break;
+        }
+        crop_ms += elapsedMs(start);
+        edfAPI.edfFreeCropImage(mmr_state, &crop);
+    }
+    std::cout << "pyramid (" << SIMD_LEVEL_NAMES[edfPyramidSimdLevel()] << ") + edfCropImagePyramid:  "
+              << (build_ms + crop_ms) / option_iterations << " ms (build " << build_ms / option_iterations
+              << " ms, crop " << crop_ms / option_iterations << " ms)" << std::endl;
+
+    //////////////////////////////////////////////////////////////
+    // Pyramid build time per downscaling kernel
+    //////////////////////////////////////////////////////////////
+    int best_level = edfPyramidSimdLevel();
+    for (int level = EDF_SIMD_SCALAR; level <= EDF_SIMD_NEON; level++) {
+        if (edfPyramidSetSimdLevel(level) != 0) {
+            continue;
+        }
+        time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < option_iterations; i++) {
+            edfBuildImagePyramid(&edfAPI, &image, &pyramid_config, &pyramid);
+        }
+        std::cout << "pyramid build, " << SIMD_LEVEL_NAMES[level] << ":\t" << elapsedMs(start) / option_iterations
+                  << " ms" << std::endl;
+    }
+    edfPyramidSetSimdLevel(best_level);
+
+    //////////////////////////////////////////////////////////////
+    // Cleaning up
+    //////////////////////////////////////////////////////////////
+    edfFreeImagePyramid(&edfAPI, &pyramid);
+    edfAPI.edfCropParamsFree(&params);
+    delete[] image.data;
+    edfAPI.erImageFree(&image);
+    edfAPI.edfFreeEyedentify(&mmr_state);
+    return 0;
+}
+
+ERImage upscaleImage(EdfAPI &api, const ERImage &image, int factor) {
+    unsigned int width  = image.width * factor;
+    unsigned int height = image.height * factor;
+    unsigned int depth  = image.depth;
+    unsigned char *data = new unsigned char[(size_t)width * height * depth];
+    for (unsigned int y = 0; y < height; y++) {
+        const unsigned char *src = image.row_data[y / factor];
+        unsigned char *dst = data + (size_t)y * width * depth;
+        for (unsigned int x = 0; x < width; x++) {
+            std::memcpy(dst + x * depth, src + (x / factor) * depth, depth);
+        }
+    }
+    ERImage upscaled;
+    // The data are user allocated, erImageFree() does not delete them.
+    api.erImageAllocateAndWrap(&upscaled, width, height, image.color_model, image.data_type, data, width * depth);
+    return upscaled;
+}
+
+bool check_arg(const char *arg, std::string option, std::string &retv)
+{
+    if (option.back()!='=' && strlen(arg) != option.length())
+        return false;
+
+    if (option.compare(0,option.length(),arg,option.length()) == 0)
+    {
+        retv.assign(arg+option.length());
+        return true;
+    }
+    return false;
+}
+
+int parse_arguments(int argc, char * argv[], bool &help, std::string &image_file, int &iterations, int &upscale)
+{
+    help = false;
+    for( int i = 1; i < argc; i++ )
+    {
+        std::string retv;
+        if (check_arg(argv[i], "-image=", retv))
+            image_file = retv;
+        else if (check_arg(argv[i], "-iterations=", retv))
+            iterations = atoi(retv.c_str());
+        else if (check_arg(argv[i], "-upscale=", retv))
+            upscale = atoi(retv.c_str());
+        else if (check_arg(argv[i], "-h", retv) || check_arg(argv[i], "--help", retv)){
+            printf("NAME\n"
+            "        example-crop-bench - Microbenchmark of the vehicle image cropping.\n\n"
+            "SYNOPSIS\n"
+            "        Unix   : ./example-crop-bench [options]\n"
+            "        Windows: example-crop-bench.exe [options]\n"
+            "\n"
+            "DESCRIPTION\n"
+            "        The example crops one vehicle (CARBOX alignment) from an upscaled frame using edfCropImage\n"
+            "        with and without antialiasing and using the SIMD image pyramid of edf-utils/edf-pyramid.h,\n"
+            "        and prints the average times.\n\n"
+            "OPTIONS\n"
+            "        -h, --help this help\n"
+            "        -image=FILE \n"
+            "                   input image, the default CARBOX annotation of car_cz.jpg is used [default %s]\n"
+            "        -iterations=N \n"
+            "                   number of measured iterations [default %d]\n"
+            "        -upscale=N \n"
+            "                   upscale factor of the input image [default %d]\n"
+            "\n"
+            "(C) 2024, Eyedea Recognition s.r.o., http://www.eyedea.cz\n"
+            "\n", DEFAULT_IMAGE, DEFAULT_ITERATIONS, DEFAULT_UPSCALE);
+            help = true;
+            return 0;
+        }
+        else{
+            printf("WARNING: Unknown option %s\nSee `%s --help' for more information.\n",argv[i], argv[0]);
+            return -1;
+        }
+    }
+    if (iterations < 1 || upscale < 1) {
+        printf("WARNING: -iterations and -upscale must be positive\n");
+        return -1;
+    }
+    return 0;
+}
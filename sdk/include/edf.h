@@ -70,9 +70,11 @@ ER_FUNCTION_PREFIX void edfFreeEyedentify(void** module_state);
 //      be prealigned with model dependent registration technique. See examples.                                    //
 //                                                                                                                  //
 //      input:          img          - registered and aligned image using edfCropImage                              //
+//                                     (array of config->batch_size images when config->batch_size > 1)             //
 //                      module_state - pointer to the module state                                                  //
 //                      config       - descriptor computation configuration (can be NULL)                           //
 //      output:         descriptor   - pointer to a user defined EdfDescriptor structure to fill                    //
+//                                     (array of config->batch_size structures when config->batch_size > 1)         //
 //                                                                                                                  //
 //      return value:   0 on success, error code on failure                                                         //
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
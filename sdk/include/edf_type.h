@@ -151,6 +151,8 @@ typedef struct {
     unsigned int batch_size; // Size of the input data batch.
                              // Set 0 to disable batch processing.
                              // Set 1-N to set the size of the batch (value 1 has the same effect as 0).
+                             // With batch_size N > 1 the edfComputeDesc img and descriptor arguments are arrays of N elements.
+                             // batch_size N > 1 is not supported by every module, check the backend before enabling it.
                              // Using sdks/modules/edftf2lite-* backend requires setting batch_size to 0 or 1. May change in a future release.
 } EdfComputeDescConfig;
 